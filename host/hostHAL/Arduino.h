@@ -0,0 +1,111 @@
+/**
+ *  @file    Arduino.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host (Linux) stand-in for the Arduino core so the remote I/O firmware
+ *  can be compiled and run as a regular process.
+ *  Only what the firmware and its libraries use is provided. Pins and the
+ *  ADC are backed by the simulated I/O table in HostIO.h
+ */
+
+#ifndef HOSTHAL_ARDUINO_H
+#define HOSTHAL_ARDUINO_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "avr/pgmspace.h"
+
+#define ARDUINO_HOST 1
+
+// the target's clock, for code that converts time to cycles
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define NOT_AN_INTERRUPT -1
+
+// 16 bit like the AVR target. MbData and the modbus frames rely on it
+typedef uint16_t word;
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define lowByte(w) ((uint8_t)((w)&0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue)                                         \
+  (bitvalue ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+inline uint16_t makeWord(uint16_t w) { return w; }
+inline uint16_t makeWord(uint8_t h, uint8_t l) { return (h << 8) | l; }
+#define word(...) makeWord(__VA_ARGS__)
+
+#define constrain(amt, low, high)                                              \
+  ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#ifdef __cplusplus
+#include <algorithm>
+using std::max;
+using std::min;
+#endif
+
+// AVR MCU status register. Written once in setup()
+extern volatile uint8_t MCUSR;
+
+void init();
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogReference(uint8_t mode);
+void analogWrite(uint8_t pin, int val);
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode);
+void detachInterrupt(uint8_t interruptNum);
+int digitalPinToInterrupt(uint8_t pin);
+
+void interrupts();
+void noInterrupts();
+
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+void setup(void);
+void loop(void);
+
+#ifdef __cplusplus
+#include "Print.h"
+#include "Stream.h"
+#include "HardwareSerial.h"
+#include "HostIO.h"
+#endif
+
+#endif // HOSTHAL_ARDUINO_H
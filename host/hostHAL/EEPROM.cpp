@@ -0,0 +1,60 @@
+/**
+ *  @file    EEPROM.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  File backed EEPROM for the host build. Every byte write goes straight
+ *  to the file so a killed process loses nothing the unit would keep
+ **/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "EEPROM.h"
+
+EEPROMClass EEPROM;
+
+void EEPROMClass::open() {
+  const char *path = getenv("HOSTHAL_EEPROM");
+
+  loaded = true;
+  memset(image, 0xFF, sizeof(image));
+
+  fd = ::open(path != NULL ? path : "remoteIO.eeprom", O_RDWR | O_CREAT, 0644);
+  if (fd < 0)
+    return;
+
+  ssize_t n = pread(fd, image, sizeof(image), 0);
+
+  // extend a new/short file with erased cells
+  if (n < (ssize_t)sizeof(image))
+    pwrite(fd, image + (n < 0 ? 0 : n), sizeof(image) - (n < 0 ? 0 : n),
+           n < 0 ? 0 : n);
+}
+
+uint8_t EEPROMClass::read(int idx) {
+  if (!loaded)
+    open();
+  if (idx < 0 || idx >= HOSTHAL_EEPROM_SIZE)
+    return 0xFF;
+  return image[idx];
+}
+
+void EEPROMClass::write(int idx, uint8_t val) {
+  if (!loaded)
+    open();
+  if (idx < 0 || idx >= HOSTHAL_EEPROM_SIZE)
+    return;
+
+  image[idx] = val;
+  if (fd >= 0)
+    pwrite(fd, &val, 1, idx);
+}
+
+void EEPROMClass::update(int idx, uint8_t val) {
+  if (read(idx) != val)
+    write(idx, val);
+}
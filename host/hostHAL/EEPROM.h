@@ -0,0 +1,54 @@
+/**
+ *  @file    EEPROM.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the AVR EEPROM library.
+ *  The 4K of the ATmega2560 is kept in the file named by HOSTHAL_EEPROM
+ *  (default remoteIO.eeprom) so settings survive restarts like on the
+ *  unit. A fresh file reads back as erased (0xFF)
+ */
+
+#ifndef HOSTHAL_EEPROM_H
+#define HOSTHAL_EEPROM_H
+
+#include "Arduino.h"
+
+#define HOSTHAL_EEPROM_SIZE 4096
+
+class EEPROMClass {
+public:
+  uint8_t read(int idx);
+  void write(int idx, uint8_t val);
+  void update(int idx, uint8_t val);
+  uint16_t length() { return HOSTHAL_EEPROM_SIZE; }
+
+  template <typename T> T &get(int idx, T &t) {
+    uint8_t *ptr = (uint8_t *)&t;
+
+    for (size_t i = 0; i < sizeof(T); i++)
+      *ptr++ = read(idx + i);
+    return t;
+  }
+
+  template <typename T> const T &put(int idx, const T &t) {
+    const uint8_t *ptr = (const uint8_t *)&t;
+
+    for (size_t i = 0; i < sizeof(T); i++)
+      update(idx + i, *ptr++);
+    return t;
+  }
+
+private:
+  void open();
+  int fd = -1;
+  bool loaded = false;
+  uint8_t image[HOSTHAL_EEPROM_SIZE];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOSTHAL_EEPROM_H
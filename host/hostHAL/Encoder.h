@@ -0,0 +1,33 @@
+/**
+ *  @file    Encoder.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the quadrature Encoder library. The count lives in
+ *  the simulated I/O table so a harness can move the light positioner
+ */
+
+#ifndef HOSTHAL_ENCODER_H
+#define HOSTHAL_ENCODER_H
+
+#include "Arduino.h"
+
+class Encoder {
+public:
+  Encoder(uint8_t pin1, uint8_t pin2) : slot(HostIO::encoderSlot(pin1)) {}
+
+  int32_t read() { return slot < 0 ? 0 : HostIO::table().encoder[slot]; }
+
+  void write(int32_t p) {
+    if (slot >= 0)
+      HostIO::table().encoder[slot] = p;
+  }
+
+private:
+  int8_t slot;
+};
+
+#endif // HOSTHAL_ENCODER_H
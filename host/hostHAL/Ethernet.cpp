@@ -0,0 +1,248 @@
+/**
+ *  @file    Ethernet.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  W5100 socket pool emulated with POSIX sockets. Reads never block;
+ *  writes block like the W5100 send buffer does when full
+ **/
+
+// before the socket headers: <netinet/in.h> defines an INADDR_NONE macro
+#include "Ethernet.h"
+
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+EthernetClass Ethernet;
+
+struct _hostSocket {
+  int fd;
+  uint16_t port; // local listening port, 0 for outbound clients
+};
+
+static _hostSocket sockets[MAX_SOCK_NUM] = {
+    {-1, 0}, {-1, 0}, {-1, 0}, {-1, 0}, {-1, 0}, {-1, 0}, {-1, 0}, {-1, 0}};
+
+static uint16_t portOffset() {
+  const char *offset = getenv("HOSTHAL_PORT_OFFSET");
+  return offset != NULL ? atoi(offset) : 0;
+}
+
+static int8_t allocateSocket(int aFd, uint16_t aPort) {
+  for (uint8_t i = 0; i < MAX_SOCK_NUM; i++) {
+    if (sockets[i].fd < 0) {
+      int flag = 1;
+      setsockopt(aFd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+      sockets[i].fd = aFd;
+      sockets[i].port = aPort;
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void releaseSocket(uint8_t aIndex) {
+  if (aIndex < MAX_SOCK_NUM && sockets[aIndex].fd >= 0) {
+    close(sockets[aIndex].fd);
+    sockets[aIndex].fd = -1;
+  }
+}
+
+// -1 if the socket is closed or reset, otherwise bytes waiting
+static int pendingBytes(uint8_t aIndex) {
+  if (aIndex >= MAX_SOCK_NUM || sockets[aIndex].fd < 0)
+    return -1;
+
+  int fd = sockets[aIndex].fd;
+  int n = 0;
+
+  if (ioctl(fd, FIONREAD, &n) < 0)
+    return -1;
+  if (n > 0)
+    return n;
+
+  uint8_t c;
+  ssize_t r = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+
+  if (r == 0 || (r < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+    return -1;
+  return 0;
+}
+
+int EthernetClass::begin(uint8_t *mac, unsigned long timeout,
+                         unsigned long responseTimeout) {
+  return 1;
+}
+
+void EthernetClass::begin(uint8_t *mac, IPAddress ip) {
+  begin(mac, ip, IPAddress(ip[0], ip[1], ip[2], 1));
+}
+
+void EthernetClass::begin(uint8_t *mac, IPAddress ip, IPAddress dns) {
+  begin(mac, ip, dns, IPAddress(ip[0], ip[1], ip[2], 1));
+}
+
+void EthernetClass::begin(uint8_t *mac, IPAddress ip, IPAddress dns,
+                          IPAddress gateway) {
+  begin(mac, ip, dns, gateway, IPAddress(255, 255, 255, 0));
+}
+
+void EthernetClass::begin(uint8_t *mac, IPAddress ip, IPAddress dns,
+                          IPAddress gateway, IPAddress subnet) {
+  _ip = ip;
+  _gateway = gateway;
+  _subnet = subnet;
+}
+
+void EthernetServer::begin() {
+  if (listenFd >= 0)
+    return;
+
+  struct sockaddr_in addr;
+  int flag = 1;
+
+  listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (listenFd < 0)
+    return;
+
+  setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_ANY);
+  addr.sin_port = htons(_port + portOffset());
+
+  if (bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      listen(listenFd, MAX_LISTEN_NUM) < 0) {
+    Serial.print(F("EthernetServer: cannot listen on "));
+    Serial.println(_port + portOffset());
+    close(listenFd);
+    listenFd = -1;
+    return;
+  }
+  fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL) | O_NONBLOCK);
+}
+
+void EthernetServer::acceptPending() {
+  int fd;
+
+  while (listenFd >= 0 && (fd = ::accept(listenFd, NULL, NULL)) >= 0) {
+    // pool exhausted: the W5100 would not have answered the SYN either
+    if (allocateSocket(fd, _port) < 0)
+      close(fd);
+  }
+}
+
+EthernetClient EthernetServer::available() {
+  // like the W5100 library, a server that was never begun starts listening
+  // on first use (MgsModbus relies on this)
+  if (listenFd < 0)
+    begin();
+  acceptPending();
+
+  for (uint8_t i = 0; i < MAX_SOCK_NUM; i++) {
+    if (sockets[i].fd < 0 || sockets[i].port != _port)
+      continue;
+
+    int n = pendingBytes(i);
+
+    if (n < 0)
+      releaseSocket(i);
+    else if (n > 0)
+      return EthernetClient(i);
+  }
+  return EthernetClient();
+}
+
+size_t EthernetServer::write(const uint8_t *buf, size_t size) {
+  acceptPending();
+
+  for (uint8_t i = 0; i < MAX_SOCK_NUM; i++)
+    if (sockets[i].fd >= 0 && sockets[i].port == _port)
+      EthernetClient(i).write(buf, size);
+  return size;
+}
+
+int EthernetClient::connect(IPAddress ip, uint16_t port) {
+  struct sockaddr_in addr;
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+  if (fd < 0)
+    return 0;
+
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  memcpy(&addr.sin_addr.s_addr, &ip[0], 4);
+
+  int8_t s;
+
+  if (::connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 ||
+      (s = allocateSocket(fd, 0)) < 0) {
+    close(fd);
+    return 0;
+  }
+  sockindex = s;
+  return 1;
+}
+
+size_t EthernetClient::write(uint8_t aByte) { return write(&aByte, 1); }
+
+size_t EthernetClient::write(const uint8_t *buf, size_t size) {
+  if (sockindex >= MAX_SOCK_NUM || sockets[sockindex].fd < 0)
+    return 0;
+
+  size_t sent = 0;
+
+  while (sent < size) {
+    ssize_t n = send(sockets[sockindex].fd, buf + sent, size - sent,
+                     MSG_NOSIGNAL);
+    if (n <= 0)
+      break;
+    sent += n;
+  }
+  return sent;
+}
+
+int EthernetClient::available() {
+  int n = pendingBytes(sockindex);
+  return n < 0 ? 0 : n;
+}
+
+int EthernetClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int EthernetClient::read(uint8_t *buf, size_t size) {
+  if (sockindex >= MAX_SOCK_NUM || sockets[sockindex].fd < 0)
+    return -1;
+
+  ssize_t n = recv(sockets[sockindex].fd, buf, size, MSG_DONTWAIT);
+  return n <= 0 ? -1 : n;
+}
+
+int EthernetClient::peek() {
+  uint8_t c;
+
+  if (sockindex >= MAX_SOCK_NUM || sockets[sockindex].fd < 0)
+    return -1;
+  if (recv(sockets[sockindex].fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) != 1)
+    return -1;
+  return c;
+}
+
+void EthernetClient::stop() {
+  releaseSocket(sockindex);
+  sockindex = MAX_SOCK_NUM;
+}
+
+uint8_t EthernetClient::connected() { return pendingBytes(sockindex) >= 0; }
@@ -0,0 +1,94 @@
+/**
+ *  @file    Ethernet.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the W5100 Ethernet library on POSIX sockets.
+ *  Like the W5100 there is a fixed pool of MAX_SOCK_NUM sockets shared by
+ *  all servers and clients. Listening ports are offset by
+ *  HOSTHAL_PORT_OFFSET (default 0) so the unit can run without root,
+ *  e.g. HOSTHAL_PORT_OFFSET=10000 serves Modbus on 10502.
+ *  The MAC/IP passed to Ethernet.begin() are only recorded; the host's
+ *  own interfaces are used.
+ */
+
+#ifndef HOSTHAL_ETHERNET_H
+#define HOSTHAL_ETHERNET_H
+
+#include "Arduino.h"
+#include "IPAddress.h"
+
+#define MAX_SOCK_NUM 8
+#define MAX_LISTEN_NUM 4
+
+class EthernetClient : public Stream {
+public:
+  EthernetClient() : sockindex(MAX_SOCK_NUM) {}
+  EthernetClient(uint8_t s) : sockindex(s) {}
+
+  int connect(IPAddress ip, uint16_t port);
+  int connect(const uint8_t *ip, uint16_t port) {
+    return connect(IPAddress(ip), port);
+  }
+  size_t write(uint8_t aByte);
+  size_t write(const uint8_t *buf, size_t size);
+  using Print::write;
+  int available();
+  int read();
+  int read(uint8_t *buf, size_t size);
+  int peek();
+  void flush() {}
+  void stop();
+  uint8_t connected();
+  operator bool() { return sockindex < MAX_SOCK_NUM; }
+  bool operator==(const EthernetClient &rhs) const {
+    return sockindex == rhs.sockindex;
+  }
+  uint8_t getSocketNumber() const { return sockindex; }
+
+private:
+  uint8_t sockindex; // MAX_SOCK_NUM means invalid
+};
+
+class EthernetServer : public Print {
+public:
+  EthernetServer(uint16_t port) : _port(port) {}
+  void begin();
+  EthernetClient available();
+  EthernetClient accept() { return available(); }
+  size_t write(uint8_t aByte) { return write(&aByte, 1); }
+  size_t write(const uint8_t *buf, size_t size);
+  using Print::write;
+
+private:
+  void acceptPending();
+  uint16_t _port;
+  int listenFd = -1;
+};
+
+class EthernetClass {
+public:
+  int begin(uint8_t *mac, unsigned long timeout = 60000,
+            unsigned long responseTimeout = 4000);
+  void begin(uint8_t *mac, IPAddress ip);
+  void begin(uint8_t *mac, IPAddress ip, IPAddress dns);
+  void begin(uint8_t *mac, IPAddress ip, IPAddress dns, IPAddress gateway);
+  void begin(uint8_t *mac, IPAddress ip, IPAddress dns, IPAddress gateway,
+             IPAddress subnet);
+  int maintain() { return 0; }
+  IPAddress localIP() { return _ip; }
+  IPAddress subnetMask() { return _subnet; }
+  IPAddress gatewayIP() { return _gateway; }
+
+private:
+  IPAddress _ip;
+  IPAddress _subnet;
+  IPAddress _gateway;
+};
+
+extern EthernetClass Ethernet;
+
+#endif // HOSTHAL_ETHERNET_H
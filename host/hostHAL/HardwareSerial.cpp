@@ -0,0 +1,96 @@
+/**
+ *  @file    HardwareSerial.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the AVR UARTs. All I/O is non-blocking so a silent
+ *  port never stalls loop(), like the real UART
+ **/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include "Arduino.h"
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+HardwareSerial Serial3(3);
+
+HardwareSerial::HardwareSerial(uint8_t aPortNumber)
+    : portNumber(aPortNumber) {}
+
+void HardwareSerial::open() {
+  if (portNumber == 0) {
+    readFd = STDIN_FILENO;
+    writeFd = STDOUT_FILENO;
+  } else {
+    char name[20];
+    snprintf(name, sizeof(name), "HOSTHAL_SERIAL%u", portNumber);
+    const char *path = getenv(name);
+
+    if (path == NULL)
+      return;
+    readFd = writeFd = ::open(path, O_RDWR | O_NOCTTY);
+  }
+
+  if (readFd >= 0)
+    fcntl(readFd, F_SETFL, fcntl(readFd, F_GETFL) | O_NONBLOCK);
+}
+
+void HardwareSerial::begin(unsigned long baud, uint8_t config) {
+  if (readFd < 0)
+    open();
+}
+
+void HardwareSerial::end() {
+  if (portNumber != 0 && readFd >= 0)
+    close(readFd);
+  readFd = writeFd = -1;
+}
+
+int HardwareSerial::peek() {
+  if (peeked < 0)
+    peeked = read();
+  return peeked;
+}
+
+int HardwareSerial::available() {
+  if (peek() < 0)
+    return 0;
+  return 1;
+}
+
+int HardwareSerial::read() {
+  uint8_t c;
+
+  if (peeked >= 0) {
+    int rv = peeked;
+    peeked = -1;
+    return rv;
+  }
+
+  if (readFd < 0 || ::read(readFd, &c, 1) != 1)
+    return -1;
+  return c;
+}
+
+int HardwareSerial::availableForWrite() { return writeFd < 0 ? 0 : 63; }
+
+void HardwareSerial::flush() {}
+
+size_t HardwareSerial::write(uint8_t aByte) { return write(&aByte, 1); }
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  // like the AVR driver, writes to a closed port are swallowed
+  if (writeFd < 0)
+    return size;
+
+  ssize_t n = ::write(writeFd, buffer, size);
+  return n < 0 ? 0 : n;
+}
@@ -0,0 +1,51 @@
+/**
+ *  @file    HardwareSerial.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the AVR UARTs.
+ *  Serial is bound to stdin/stdout. Serial1..Serial3 are bound to the
+ *  file/pipe/pty named by HOSTHAL_SERIAL1..HOSTHAL_SERIAL3 and behave as
+ *  a disconnected port when the variable is not set
+ */
+
+#ifndef HOSTHAL_HARDWARESERIAL_H
+#define HOSTHAL_HARDWARESERIAL_H
+
+#include "Stream.h"
+
+#define SERIAL_8N1 0x06
+
+class HardwareSerial : public Stream {
+public:
+  HardwareSerial(uint8_t aPortNumber);
+  void begin(unsigned long baud) { begin(baud, SERIAL_8N1); }
+  void begin(unsigned long baud, uint8_t config);
+  void end();
+  int available();
+  int peek();
+  int read();
+  int availableForWrite();
+  void flush();
+  size_t write(uint8_t aByte);
+  size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+  operator bool() { return true; }
+
+private:
+  void open();
+  uint8_t portNumber;
+  int readFd = -1;
+  int writeFd = -1;
+  int peeked = -1;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
+
+#endif // HOSTHAL_HARDWARESERIAL_H
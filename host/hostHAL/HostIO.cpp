@@ -0,0 +1,167 @@
+/**
+ *  @file    HostIO.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Simulated I/O table and the Arduino pin/ADC/interrupt API on top of it
+ **/
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "Arduino.h"
+
+// Mega 2560: A0 is digital pin 54
+#define HOSTIO_FIRST_ANALOG_PIN 54
+
+// external interrupt number -> pin (INT0..INT5 on the 2560)
+static const uint8_t interruptPins[] = {21, 20, 19, 18, 2, 3};
+#define HOSTIO_INTERRUPT_COUNT (sizeof(interruptPins) / sizeof(uint8_t))
+
+struct _hostIOInterrupt {
+  void (*handler)(void);
+  int mode;
+};
+
+static _hostIOInterrupt isrTable[HOSTIO_PIN_COUNT];
+static HostIOTable localTable;
+static HostIOTable *ioTable = NULL;
+
+void HostIO::begin() {
+  if (ioTable != NULL)
+    return;
+
+  const char *path = getenv("HOSTHAL_IO_FILE");
+
+  if (path != NULL) {
+    int fd = open(path, O_RDWR | O_CREAT, 0644);
+
+    if (fd >= 0 && ftruncate(fd, sizeof(HostIOTable)) == 0) {
+      void *p = mmap(NULL, sizeof(HostIOTable), PROT_READ | PROT_WRITE,
+                     MAP_SHARED, fd, 0);
+      if (p != MAP_FAILED)
+        ioTable = (HostIOTable *)p;
+    }
+    if (fd >= 0)
+      close(fd);
+  }
+
+  if (ioTable == NULL)
+    ioTable = &localTable;
+
+  if (ioTable->magic != HOSTIO_MAGIC) {
+    memset(ioTable, 0, sizeof(HostIOTable));
+    ioTable->magic = HOSTIO_MAGIC;
+  }
+}
+
+HostIOTable &HostIO::table() {
+  begin();
+  return *ioTable;
+}
+
+void HostIO::setPin(uint8_t aPin, bool aLevel) {
+  if (aPin >= HOSTIO_PIN_COUNT)
+    return;
+
+  bool previous = table().pinLevel[aPin];
+  table().pinLevel[aPin] = aLevel;
+
+  _hostIOInterrupt &isr = isrTable[aPin];
+
+  if (isr.handler == NULL || previous == aLevel)
+    return;
+
+  if (isr.mode == CHANGE || (isr.mode == RISING && aLevel) ||
+      (isr.mode == FALLING && !aLevel))
+    isr.handler();
+}
+
+void HostIO::setAnalog(uint8_t aChannel, uint16_t aValue) {
+  if (aChannel < HOSTIO_ANALOG_COUNT)
+    table().adc[aChannel] = aValue & 0x3FF;
+}
+
+void HostIO::attach(uint8_t aPin, void (*aHandler)(void), int aMode) {
+  if (aPin < HOSTIO_PIN_COUNT) {
+    isrTable[aPin].handler = aHandler;
+    isrTable[aPin].mode = aMode;
+  }
+}
+
+void HostIO::detach(uint8_t aPin) {
+  if (aPin < HOSTIO_PIN_COUNT)
+    isrTable[aPin].handler = NULL;
+}
+
+int8_t HostIO::encoderSlot(uint8_t aPin) {
+  HostIOTable &t = table();
+
+  for (uint8_t i = 0; i < HOSTIO_ENCODER_COUNT; i++) {
+    if (t.encoderPin[i] == aPin)
+      return i;
+    if (t.encoderPin[i] == 0) {
+      t.encoderPin[i] = aPin;
+      return i;
+    }
+  }
+  return -1;
+}
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  if (pin < HOSTIO_PIN_COUNT) {
+    HostIO::table().pinMode[pin] = mode;
+    if (mode == INPUT_PULLUP)
+      HostIO::table().pinLevel[pin] = HIGH;
+  }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if (pin < HOSTIO_PIN_COUNT)
+    HostIO::table().pinLevel[pin] = val != LOW;
+}
+
+int digitalRead(uint8_t pin) {
+  if (pin < HOSTIO_PIN_COUNT)
+    return HostIO::table().pinLevel[pin];
+  return LOW;
+}
+
+int analogRead(uint8_t pin) {
+  if (pin >= HOSTIO_FIRST_ANALOG_PIN)
+    pin -= HOSTIO_FIRST_ANALOG_PIN;
+  if (pin < HOSTIO_ANALOG_COUNT)
+    return HostIO::table().adc[pin];
+  return 0;
+}
+
+void analogReference(uint8_t mode) {}
+
+void analogWrite(uint8_t pin, int val) {
+  if (pin < HOSTIO_PIN_COUNT) {
+    HostIO::table().pwm[pin] = val;
+    HostIO::table().pinLevel[pin] = val != 0;
+  }
+}
+
+int digitalPinToInterrupt(uint8_t pin) {
+  for (uint8_t i = 0; i < HOSTIO_INTERRUPT_COUNT; i++)
+    if (interruptPins[i] == pin)
+      return i;
+  return NOT_AN_INTERRUPT;
+}
+
+void attachInterrupt(uint8_t interruptNum, void (*userFunc)(void), int mode) {
+  if (interruptNum < HOSTIO_INTERRUPT_COUNT)
+    HostIO::attach(interruptPins[interruptNum], userFunc, mode);
+}
+
+void detachInterrupt(uint8_t interruptNum) {
+  if (interruptNum < HOSTIO_INTERRUPT_COUNT)
+    HostIO::detach(interruptPins[interruptNum]);
+}
@@ -0,0 +1,56 @@
+/**
+ *  @file    HostIO.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Simulated I/O table used by the host build in place of the AVR pins,
+ *  ADC and encoder.
+ *  When HOSTHAL_IO_FILE names a file the table is mapped shared from it,
+ *  so a test or benchmark process can drive inputs and watch outputs of
+ *  the running firmware. Otherwise it lives in process memory.
+ *  Driving an input through HostIO::setPin() fires any ISR attached to
+ *  that pin with the same edge rules as the AVR external interrupts
+ */
+
+#ifndef HOSTHAL_HOSTIO_H
+#define HOSTHAL_HOSTIO_H
+
+#include <stdint.h>
+
+#define HOSTIO_PIN_COUNT 80
+#define HOSTIO_ANALOG_COUNT 16
+#define HOSTIO_ENCODER_COUNT 4
+#define HOSTIO_MAGIC 0x494F5448UL // "HTOI"
+
+struct _hostIOTable {
+  uint32_t magic;
+  uint8_t pinLevel[HOSTIO_PIN_COUNT]; // driven input or written output
+  uint8_t pinMode[HOSTIO_PIN_COUNT];
+  int16_t pwm[HOSTIO_PIN_COUNT];       // last analogWrite() value
+  uint16_t adc[HOSTIO_ANALOG_COUNT];   // 10 bit ADC counts, A0 = index 0
+  int32_t encoder[HOSTIO_ENCODER_COUNT];
+  uint8_t encoderPin[HOSTIO_ENCODER_COUNT]; // first pin of each encoder
+};
+
+typedef _hostIOTable HostIOTable;
+
+namespace HostIO {
+void begin();
+HostIOTable &table();
+
+// driven from outside the firmware, e.g. a test harness
+void setPin(uint8_t aPin, bool aLevel);
+void setAnalog(uint8_t aChannel, uint16_t aValue);
+
+// the firmware's interrupt handlers for the external interrupt pins
+void attach(uint8_t aPin, void (*aHandler)(void), int aMode);
+void detach(uint8_t aPin);
+
+// returns the encoder slot for a pin pair, allocating one if needed
+int8_t encoderSlot(uint8_t aPin);
+} // namespace HostIO
+
+#endif // HOSTHAL_HOSTIO_H
@@ -0,0 +1,97 @@
+/**
+ *  @file    HostMain.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the Arduino wiring/main. Runs setup() once then
+ *  loop() forever. HOSTHAL_LOOP_SLEEP_US throttles loop() (default 100 us)
+ *  so an idle unit does not spin a host core; set it to 0 when
+ *  benchmarking.
+ **/
+
+#include <sched.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <avr/wdt.h>
+
+#include "Arduino.h"
+#include "SPI.h"
+
+volatile uint8_t MCUSR = 0;
+SPIClass SPI;
+
+static struct timespec startTime;
+static char **hostArgv = NULL;
+
+static uint64_t elapsedMicros() {
+  struct timespec now;
+
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (uint64_t)(now.tv_sec - startTime.tv_sec) * 1000000ULL +
+         (now.tv_nsec - startTime.tv_nsec) / 1000;
+}
+
+void init() {
+  clock_gettime(CLOCK_MONOTONIC, &startTime);
+  signal(SIGPIPE, SIG_IGN); // peer resets are seen as failed writes
+  HostIO::begin();
+}
+
+// both wrap like the AVR counters
+unsigned long millis() { return (uint32_t)(elapsedMicros() / 1000); }
+
+unsigned long micros() { return (uint32_t)elapsedMicros(); }
+
+void delay(unsigned long ms) { usleep(ms * 1000); }
+
+void delayMicroseconds(unsigned int us) { usleep(us); }
+
+// there is no ISR context on the host: handlers run inline from
+// HostIO::setPin() on the loop() thread
+void interrupts() {}
+
+void noInterrupts() {}
+
+long random(long howbig) { return howbig == 0 ? 0 : rand() % howbig; }
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig)
+    return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) { srand(seed); }
+
+void wdt_enable(uint8_t timeout) {
+  fflush(NULL);
+  if (hostArgv != NULL)
+    execv("/proc/self/exe", hostArgv);
+  _exit(0);
+}
+
+void wdt_disable() {}
+
+void wdt_reset() {}
+
+int main(int argc, char **argv) {
+  const char *sleep = getenv("HOSTHAL_LOOP_SLEEP_US");
+  useconds_t loopSleep = sleep != NULL ? atol(sleep) : 100;
+
+  hostArgv = argv;
+  init();
+  setup();
+
+  for (;;) {
+    loop();
+    if (loopSleep)
+      usleep(loopSleep);
+    else
+      sched_yield();
+  }
+  return 0;
+}
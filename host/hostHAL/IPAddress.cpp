@@ -0,0 +1,25 @@
+/**
+ *  @file    IPAddress.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the Arduino IPAddress class
+ **/
+
+#include "IPAddress.h"
+
+const IPAddress INADDR_NONE(0, 0, 0, 0);
+
+size_t IPAddress::printTo(Print &p) const {
+  size_t n = 0;
+
+  for (int i = 0; i < 3; i++) {
+    n += p.print(_address.bytes[i], DEC);
+    n += p.print('.');
+  }
+  n += p.print(_address.bytes[3], DEC);
+  return n;
+}
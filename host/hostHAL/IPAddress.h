@@ -0,0 +1,53 @@
+/**
+ *  @file    IPAddress.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the Arduino IPAddress class. Same byte order as the
+ *  AVR core: the uint32_t conversion is the four octets in memory order
+ */
+
+#ifndef HOSTHAL_IPADDRESS_H
+#define HOSTHAL_IPADDRESS_H
+
+#include "Arduino.h"
+
+class IPAddress : public Printable {
+public:
+  IPAddress() { _address.dword = 0; }
+  IPAddress(uint8_t first_octet, uint8_t second_octet, uint8_t third_octet,
+            uint8_t fourth_octet) {
+    _address.bytes[0] = first_octet;
+    _address.bytes[1] = second_octet;
+    _address.bytes[2] = third_octet;
+    _address.bytes[3] = fourth_octet;
+  }
+  IPAddress(uint32_t address) { _address.dword = address; }
+  IPAddress(const uint8_t *address) { memcpy(_address.bytes, address, 4); }
+
+  operator uint32_t() const { return _address.dword; }
+  bool operator==(const IPAddress &addr) const {
+    return _address.dword == addr._address.dword;
+  }
+  uint8_t operator[](int index) const { return _address.bytes[index]; }
+  uint8_t &operator[](int index) { return _address.bytes[index]; }
+  IPAddress &operator=(uint32_t address) {
+    _address.dword = address;
+    return *this;
+  }
+
+  virtual size_t printTo(Print &p) const;
+
+private:
+  union {
+    uint8_t bytes[4];
+    uint32_t dword;
+  } _address;
+};
+
+extern const IPAddress INADDR_NONE;
+
+#endif // HOSTHAL_IPADDRESS_H
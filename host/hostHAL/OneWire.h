@@ -0,0 +1,50 @@
+/**
+ *  @file    OneWire.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the OneWire library: a bus with no devices on it.
+ *  Presence is never detected and reads return the idle bus level, which
+ *  is what the firmware sees with the 1-Wire cable unplugged.
+ *  crc8/crc16 are the real Dallas algorithms
+ */
+
+#ifndef HOSTHAL_ONEWIRE_H
+#define HOSTHAL_ONEWIRE_H
+
+#include "Arduino.h"
+
+class OneWire {
+public:
+  OneWire() {}
+  OneWire(uint8_t pin) { begin(pin); }
+  void begin(uint8_t /*pin*/) {}
+
+  uint8_t reset(void) { return 0; }
+  void select(const uint8_t /*rom*/[8]) {}
+  void skip(void) {}
+  void write(uint8_t /*v*/, uint8_t /*power*/ = 0) {}
+  void write_bytes(const uint8_t * /*buf*/, uint16_t /*count*/,
+                   bool /*power*/ = 0) {}
+  uint8_t read(void) { return 0xFF; }
+  void read_bytes(uint8_t *buf, uint16_t count) { memset(buf, 0xFF, count); }
+  void write_bit(uint8_t /*v*/) {}
+  uint8_t read_bit(void) { return 1; }
+  void depower(void) {}
+
+  void reset_search() {}
+  void target_search(uint8_t /*family_code*/) {}
+  bool search(uint8_t * /*newAddr*/, bool /*search_mode*/ = true) {
+    return false;
+  }
+
+  static uint8_t crc8(const uint8_t *addr, uint8_t len);
+  static bool check_crc16(const uint8_t *input, uint16_t len,
+                          const uint8_t *inverted_crc, uint16_t crc = 0);
+  static uint16_t crc16(const uint8_t *input, uint16_t len, uint16_t crc = 0);
+};
+
+#endif // HOSTHAL_ONEWIRE_H
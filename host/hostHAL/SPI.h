@@ -0,0 +1,27 @@
+/**
+ *  @file    SPI.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the SPI library. Nothing on the host talks SPI; the
+ *  W5100 is replaced by POSIX sockets in Ethernet.h
+ */
+
+#ifndef HOSTHAL_SPI_H
+#define HOSTHAL_SPI_H
+
+#include "Arduino.h"
+
+class SPIClass {
+public:
+  static void begin() {}
+  static void end() {}
+  static uint8_t transfer(uint8_t data) { return 0; }
+};
+
+extern SPIClass SPI;
+
+#endif // HOSTHAL_SPI_H
@@ -0,0 +1,37 @@
+/**
+ *  @file    Stream.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the Arduino Stream class
+ **/
+
+#include "Arduino.h"
+
+int Stream::timedRead() {
+  unsigned long startMillis = millis();
+
+  do {
+    int c = read();
+    if (c >= 0)
+      return c;
+    delay(1);
+  } while (millis() - startMillis < _timeout);
+  return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length) {
+  size_t count = 0;
+
+  while (count < length) {
+    int c = timedRead();
+    if (c < 0)
+      break;
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
@@ -0,0 +1,34 @@
+/**
+ *  @file    Stream.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Host stand-in for the Arduino Stream class
+ */
+
+#ifndef HOSTHAL_STREAM_H
+#define HOSTHAL_STREAM_H
+
+#include "Print.h"
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  void setTimeout(unsigned long timeout) { _timeout = timeout; }
+  size_t readBytes(char *buffer, size_t length);
+  size_t readBytes(uint8_t *buffer, size_t length) {
+    return readBytes((char *)buffer, length);
+  }
+
+protected:
+  int timedRead();
+  unsigned long _timeout = 1000;
+};
+
+#endif // HOSTHAL_STREAM_H
@@ -10,8 +10,18 @@ EthernetClient MbmClient;
 
 MgsModbus::MgsModbus()
 {
+#if defined(MGS_MODBUS_STATS)
+  MbsResetStats();
+#endif
 }
 
+#if defined(MGS_MODBUS_STATS)
+void MgsModbus::MbsResetStats()
+{
+  memset(&MbsStats, 0, sizeof(MbsStats));
+}
+#endif
+
 
 //****************** Send data for ModBusMaster ****************
 void MgsModbus::Req(MB_FC FC, word Ref, word Count, word Pos)
@@ -188,9 +198,47 @@ void MgsModbus::MbsRun()
       MbsByteArray[i] = client.read();
       i++;
     }
-    MbsFC = SetFC(MbsByteArray[7]);  //Byte 7 of request is FC
+    MbsProcess(client, i);
   }
-  int Start, WordDataLength, ByteDataLength, CoilDataLength, MessageLength;
+}
+
+
+//****************** Recieve data for ModBusSlave from a stream ****************
+// Same MBAP framing as TCP. Bytes are collected across calls and a frame is
+// answered on the stream once complete, so the caller never waits for data.
+void MgsModbus::MbsRun(Stream &aStream)
+{
+  while(aStream.available())
+  {
+    MbsByteArray[MbsStreamCount++] = aStream.read();
+    if(MbsStreamCount < 6) continue;
+
+    word FrameLength = word(MbsByteArray[4],MbsByteArray[5]) + 6;
+    if(FrameLength > sizeof(MbsByteArray) || FrameLength < 8) {
+      MbsStreamCount = 0; // not a frame we can hold or no unit id + FC, resync
+    }
+    else if(MbsStreamCount == FrameLength) {
+      MbsStreamCount = 0;
+      MbsProcess(aStream, FrameLength);
+      return;
+    }
+  }
+}
+
+
+//****************** Answer the request in MbsByteArray ****************
+void MgsModbus::MbsProcess(Print &client, int RequestLength)
+{
+#if defined(SIMAVR_BENCH)
+  GPIOR1 = 1; // transaction start marker for the simavr benchmark
+#endif
+  MbsFC = SetFC(MbsByteArray[7]);  //Byte 7 of request is FC
+#if defined(MGS_MODBUS_STATS)
+  unsigned long StartMicros = micros();
+  int CopiedLength = 0; // MbData bytes moved into/out of the frame
+#endif
+  int Start, WordDataLength, ByteDataLength, CoilDataLength;
+  int MessageLength = 0;
   //****************** Read Coils (1 & 2) **********************
   if(MbsFC == MB_FC_READ_COILS || MbsFC == MB_FC_READ_DISCRETE_INPUT) {
     Start = word(MbsByteArray[8],MbsByteArray[9]);
@@ -209,6 +257,9 @@ void MgsModbus::MbsRun()
       }
     }
     MessageLength = ByteDataLength + 9;
+#if defined(MGS_MODBUS_STATS)
+    CopiedLength = ByteDataLength;
+#endif
     client.write(MbsByteArray, MessageLength);
     MbsFC = MB_FC_NONE;
   }
@@ -225,6 +276,9 @@ void MgsModbus::MbsRun()
       MbsByteArray[10 + i * 2] =  lowByte(MbData[Start + i]);
     }
     MessageLength = ByteDataLength + 9;
+#if defined(MGS_MODBUS_STATS)
+    CopiedLength = ByteDataLength;
+#endif
     client.write(MbsByteArray, MessageLength);
     MbsFC = MB_FC_NONE;
   }
@@ -242,6 +296,7 @@ void MgsModbus::MbsRun()
     MessageLength = 12;
 
     client.write(MbsByteArray, MessageLength);
+    MbsWriteCount++;
     MbsFC = MB_FC_NONE;
   }
   //****************** Write Register (6) ******************
@@ -250,7 +305,11 @@ void MgsModbus::MbsRun()
     MbData[Start] = word(MbsByteArray[10],MbsByteArray[11]);
     MbsByteArray[5] = 6; //Number of bytes after this one.
     MessageLength = 12;
+#if defined(MGS_MODBUS_STATS)
+    CopiedLength = 2;
+#endif
     client.write(MbsByteArray, MessageLength);
+    MbsWriteCount++;
     MbsFC = MB_FC_NONE;
   }
   //****************** Write Multiple Coils (15) **********************
@@ -266,7 +325,11 @@ void MgsModbus::MbsRun()
       SetBit(Start + i,bitRead(MbsByteArray[13 + (i/8)],i-((i/8)*8)));
     }
     MessageLength = 12;
+#if defined(MGS_MODBUS_STATS)
+    CopiedLength = (CoilDataLength + 7) / 8;
+#endif
     client.write(MbsByteArray, MessageLength);
+    MbsWriteCount++;
     MbsFC = MB_FC_NONE;
   }
   //****************** Write Multiple Registers (16) ******************
@@ -280,9 +343,27 @@ void MgsModbus::MbsRun()
       MbData[Start + i] =  word(MbsByteArray[ 13 + i * 2],MbsByteArray[14 + i * 2]);
     }
     MessageLength = 12;
+#if defined(MGS_MODBUS_STATS)
+    CopiedLength = ByteDataLength;
+#endif
     client.write(MbsByteArray, MessageLength);
+    MbsWriteCount++;
     MbsFC = MB_FC_NONE;
   }
+#if defined(MGS_MODBUS_STATS)
+  if(MessageLength > 0) {
+    unsigned long Elapsed = micros() - StartMicros;
+    MbsStats.requests++;
+    MbsStats.bytesIn += RequestLength;
+    MbsStats.bytesOut += MessageLength;
+    MbsStats.bytesCopied += RequestLength + CopiedLength + MessageLength;
+    MbsStats.busyMicros += Elapsed;
+    if(Elapsed > MbsStats.maxMicros) MbsStats.maxMicros = min(Elapsed, 0xFFFFUL);
+  }
+#endif
+#if defined(SIMAVR_BENCH)
+  GPIOR1 = 0;
+#endif
 }
 
 
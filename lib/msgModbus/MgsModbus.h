@@ -62,9 +62,11 @@
 #ifndef MgsModbus_h
 #define MgsModbus_h
 
-#define MbDataLen 236 // length of the MdData array
+#define MbDataLen 434 // length of the MdData array, HR_TI_BLOCK ends at 433
 #define MB_PORT 502
 
+// define MGS_MODBUS_STATS to collect slave statistics (see MbsStats)
+
 enum MB_FC {
   MB_FC_NONE                     = 0,
   MB_FC_READ_COILS               = 1,
@@ -77,6 +79,18 @@ enum MB_FC {
   MB_FC_WRITE_MULTIPLE_REGISTERS = 16
 };
 
+#if defined(MGS_MODBUS_STATS)
+// slave side statistics, for benchmarking MbsRun
+struct MbsStatistics {
+  uint32_t requests;    // requests answered
+  uint32_t bytesIn;     // request bytes read from the socket
+  uint32_t bytesOut;    // response bytes written to the socket
+  uint32_t bytesCopied; // bytes moved socket <-> MbsByteArray <-> MbData
+  uint32_t busyMicros;  // time spent handling requests
+  uint16_t maxMicros;   // longest single request
+};
+#endif
+
 class MgsModbus
 {
 public:
@@ -91,7 +105,13 @@ public:
   IPAddress remSlaveIP;
   // modbus slave
   void MbsRun();
+  void MbsRun(Stream &aStream); // MBAP framed requests over e.g. a UART
   word GetDataLen();
+  word MbsWriteCount = 0; // write requests (FC 5, 6, 15, 16) handled, wraps
+#if defined(MGS_MODBUS_STATS)
+  MbsStatistics MbsStats;
+  void MbsResetStats();
+#endif
 private:
   // general
   MB_FC SetFC(int fc);
@@ -105,6 +125,8 @@ private:
   //modbus slave
   uint8_t MbsByteArray[260]; // send and recieve buffer
   MB_FC MbsFC;
+  word MbsStreamCount = 0; // bytes of the stream frame received so far
+  void MbsProcess(Print &client, int RequestLength);
 };
 
 #endif
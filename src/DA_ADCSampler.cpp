@@ -0,0 +1,119 @@
+/**
+ *  @file    DA_ADCSampler.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Interrupt driven ADC sampling into a ring buffer, see DA_ADCSampler.h
+ **/
+
+#include "DA_ADCSampler.h"
+#include <Streaming.h>
+
+DA_ADCSampler *DA_ADCSampler::instance = NULL;
+
+#if !defined(HOST_BUILD)
+ISR(ADC_vect) { DA_ADCSampler::instance->handleConversion(); }
+#endif
+
+DA_ADCSampler::DA_ADCSampler(uint8_t aFirstPin, uint8_t aChannelCount)
+    : firstPin(aFirstPin),
+      channelCount(min(aChannelCount, (uint8_t)DA_ADC_MAX_CHANNELS)) {
+  memset(latest, 0, sizeof(latest));
+}
+
+void DA_ADCSampler::begin() {
+  instance = this;
+  channel = 0;
+  conversions = 0;
+#if !defined(HOST_BUILD)
+  uint8_t channelMask = (1 << channelCount) - 1;
+
+  ADCSRA = 0;
+  DIDR0 |= channelMask;         // analog only, saves the input buffers
+  ADMUX = _BV(REFS0);           // AVcc reference like analogRead(), ADC0
+  ADCSRB = _BV(ADTS2);          // auto trigger on Timer0 overflow
+  ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) |
+           _BV(ADPS0);          // 125 kHz ADC clock, ~104 us per conversion
+#endif
+}
+
+void DA_ADCSampler::end() {
+#if !defined(HOST_BUILD)
+  ADCSRA &= ~(_BV(ADATE) | _BV(ADIE));
+  ADCSRB = 0;
+#endif
+}
+
+void DA_ADCSampler::setSampleDivider(uint8_t aDivider) {
+  divider = aDivider ? aDivider : 1;
+}
+
+inline void DA_ADCSampler::store(uint8_t aChannel, uint16_t aValue) {
+  uint8_t next = (head + 1) & DA_ADC_RING_MASK;
+
+  if (next == tail) {
+    overruns++;
+    return;
+  }
+  ring[head] = (uint16_t)aChannel << DA_ADC_CHANNEL_SHIFT | aValue;
+  head = next;
+}
+
+void DA_ADCSampler::handleConversion() {
+#if !defined(HOST_BUILD)
+  uint16_t value = ADC;
+
+  // keep every divider'th conversion, the others let the mux settle
+  if (++conversions < divider)
+    return;
+  conversions = 0;
+
+  store(channel, value);
+  if (++channel >= channelCount)
+    channel = 0;
+  // takes effect for the conversion started by the next trigger
+  ADMUX = _BV(REFS0) | channel;
+#endif
+}
+
+uint8_t DA_ADCSampler::consume() {
+  uint8_t count = 0;
+
+#if defined(HOST_BUILD)
+  // no ADC interrupt on the host, sample the simulated inputs here
+  for (uint8_t i = 0; i < channelCount; i++)
+    store(i, analogRead(firstPin + i) & DA_ADC_VALUE_MASK);
+#endif
+
+  while (tail != head) {
+    uint16_t entry = ring[tail];
+
+    tail = (tail + 1) & DA_ADC_RING_MASK;
+    uint8_t sampleChannel = entry >> DA_ADC_CHANNEL_SHIFT;
+
+    latest[sampleChannel] = entry & DA_ADC_VALUE_MASK;
+    filters[sampleChannel].addSample(latest[sampleChannel]);
+    count++;
+  }
+  samples += count;
+  return count;
+}
+
+void DA_ADCSampler::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{ADC samples:") << samples << F(" overruns:")
+                 << overruns << F(" divider:") << (int)divider << F(" raw:");
+
+  for (uint8_t i = 0; i < channelCount; i++)
+    *aOutputStream << (i ? "," : "") << latest[i];
+  *aOutputStream << F(" filtered:");
+  for (uint8_t i = 0; i < channelCount; i++)
+    *aOutputStream << (i ? "," : "") << filters[i].getValue() << "/"
+                   << _HEX(filters[i].getConfig());
+  *aOutputStream << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,81 @@
+/**
+ *  @file    DA_ADCSampler.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Free running, interrupt driven sampling of consecutive ADC channels.
+ *
+ *  The ADC is auto triggered by the Timer0 overflow (~976 Hz, the millis()
+ *  timer) and the conversion complete interrupt stores the result in a
+ *  ring buffer and moves the mux to the next channel, so the channels are
+ *  sampled round robin at evenly spaced times. With a divider of n only
+ *  every nth conversion is kept (the others also give the mux time to
+ *  settle), i.e. 976 / (channels * n) Hz per channel.
+ *
+ *  loop() only calls consume() to move finished samples out of the ring
+ *  and through each channel's DA_AnalogFilter, there is no waiting on the
+ *  ADC. Samples that find the ring full are dropped and counted.
+ *
+ *  Nothing else may use analogRead() while the sampler runs.
+ */
+
+#ifndef DA_ADCSAMPLER_H
+#define DA_ADCSAMPLER_H
+#include <Arduino.h>
+#include "DA_AnalogFilter.h"
+
+#define DA_ADC_MAX_CHANNELS 8 // ADC0..ADC7, MUX5 is not used
+#define DA_ADC_RING_SIZE 32   // power of 2
+#define DA_ADC_RING_MASK (DA_ADC_RING_SIZE - 1)
+#define DA_ADC_CHANNEL_SHIFT 12 // ring entry: channel << 12 | 10 bit value
+#define DA_ADC_VALUE_MASK 0x03FF
+
+class DA_ADCSampler {
+public:
+  DA_ADCSampler(uint8_t aFirstPin, uint8_t aChannelCount);
+  void begin();
+  void end();
+  void setSampleDivider(uint8_t aDivider);
+
+  uint8_t consume(); // drain the ring, returns samples consumed
+
+  inline uint16_t getRawSample(uint8_t aChannel) {
+    return aChannel < channelCount ? latest[aChannel] : 0;
+  }
+  // filtered, 10 + oversampling bits, see DA_AnalogFilter
+  inline uint16_t getValue(uint8_t aChannel) {
+    return aChannel < channelCount ? filters[aChannel].getValue() : 0;
+  }
+  inline void setFilterConfig(uint8_t aChannel, uint16_t aConfig) {
+    if (aChannel < channelCount)
+      filters[aChannel].setConfig(aConfig);
+  }
+  inline uint16_t getOverruns() { return overruns; }
+  inline uint8_t getChannelCount() { return channelCount; }
+
+  void handleConversion(); // ADC_vect
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+  static DA_ADCSampler *instance;
+
+private:
+  inline void store(uint8_t aChannel, uint16_t aValue);
+
+  uint8_t firstPin;
+  uint8_t channelCount;
+  volatile uint16_t ring[DA_ADC_RING_SIZE];
+  volatile uint8_t head = 0; // written by the ISR
+  volatile uint8_t tail = 0; // written by consume()
+  volatile uint16_t overruns = 0;
+  volatile uint8_t channel = 0;
+  volatile uint8_t divider = 1;
+  volatile uint8_t conversions = 0;
+  uint16_t latest[DA_ADC_MAX_CHANNELS];
+  DA_AnalogFilter filters[DA_ADC_MAX_CHANNELS];
+  uint32_t samples = 0;
+};
+
+#endif // DA_ADCSAMPLER_H
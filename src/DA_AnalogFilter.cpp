@@ -0,0 +1,97 @@
+/**
+ *  @file    DA_AnalogFilter.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Fixed point median/oversampling/IIR filter, see DA_AnalogFilter.h
+ **/
+
+#include "DA_AnalogFilter.h"
+
+DA_AnalogFilter::DA_AnalogFilter() { reset(); }
+
+void DA_AnalogFilter::reset() {
+  windowCount = 0;
+  windowIndex = 0;
+  accumulator = 0;
+  accumulated = 0;
+  iirState = 0;
+  isIIRPrimed = false;
+}
+
+void DA_AnalogFilter::setConfig(uint16_t aConfig) {
+  if (aConfig == config)
+    return;
+
+  config = aConfig;
+  oversampleExp = aConfig & DA_FILTER_OVERSAMPLE_MASK;
+  iirShift = min((aConfig >> DA_FILTER_IIR_SHIFT) & DA_FILTER_IIR_MASK,
+                 DA_FILTER_IIR_MAX);
+  switch ((aConfig >> DA_FILTER_MEDIAN_SHIFT) & DA_FILTER_MEDIAN_MASK) {
+  case 1:
+    medianSize = 3;
+    break;
+  case 2:
+    medianSize = 5;
+    break;
+  default:
+    medianSize = 1;
+  }
+  reset();
+}
+
+// median of the last medianSize samples, of fewer until the window fills
+uint16_t DA_AnalogFilter::median(uint16_t aSample) {
+  uint16_t sorted[DA_FILTER_MEDIAN_MAX];
+
+  window[windowIndex] = aSample;
+  if (++windowIndex >= medianSize)
+    windowIndex = 0;
+  if (windowCount < medianSize)
+    windowCount++;
+
+  // insertion sort, at most 5 entries
+  for (uint8_t i = 0; i < windowCount; i++) {
+    uint16_t v = window[i];
+    uint8_t j = i;
+
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+  return sorted[windowCount / 2];
+}
+
+bool DA_AnalogFilter::addSample(uint16_t aSample) {
+  uint16_t x = medianSize > 1 ? median(aSample) : aSample;
+
+  if (oversampleExp) {
+    // 4^n samples summed and shifted by n keep n extra bits
+    accumulator += x;
+    if (++accumulated < (1 << (2 * oversampleExp)))
+      return false;
+    x = accumulator >> oversampleExp;
+    accumulator = 0;
+    accumulated = 0;
+  }
+
+  if (iirShift) {
+    int32_t scaled = (int32_t)x << DA_FILTER_IIR_FRACTION_BITS;
+
+    if (!isIIRPrimed) {
+      iirState = scaled;
+      isIIRPrimed = true;
+    } else
+      iirState += (scaled - iirState) >> iirShift;
+    x = (iirState + (1 << (DA_FILTER_IIR_FRACTION_BITS - 1))) >>
+        DA_FILTER_IIR_FRACTION_BITS;
+  }
+
+  value = x;
+  return true;
+}
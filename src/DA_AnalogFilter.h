@@ -0,0 +1,63 @@
+/**
+ *  @file    DA_AnalogFilter.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Fixed point filter stage for one 10 bit analog input, no float.
+ *
+ *  Samples go through, in order:
+ *    median of 3 or 5    spike rejection on the raw samples
+ *    oversample 4^n      sum 4^n samples and decimate, 10 + n bits out
+ *    first order IIR     y += (x - y) / 2^s, 8 fractional bits of state
+ *
+ *  The stage is configured with one 16 bit word (a holding register):
+ *    bits 0-1  n, oversampling exponent 0..3
+ *    bits 4-7  s, IIR shift 0 = off .. 8
+ *    bits 8-9  median 0 = off, 1 = of 3, 2 = of 5
+ *  0 passes the raw samples through.
+ */
+
+#ifndef DA_ANALOGFILTER_H
+#define DA_ANALOGFILTER_H
+#include <Arduino.h>
+
+#define DA_FILTER_OVERSAMPLE_MASK 0x0003
+#define DA_FILTER_IIR_SHIFT 4
+#define DA_FILTER_IIR_MASK 0x000F
+#define DA_FILTER_IIR_MAX 8
+#define DA_FILTER_MEDIAN_SHIFT 8
+#define DA_FILTER_MEDIAN_MASK 0x0003
+#define DA_FILTER_MEDIAN_MAX 5
+#define DA_FILTER_IIR_FRACTION_BITS 8
+
+class DA_AnalogFilter {
+public:
+  DA_AnalogFilter();
+  void setConfig(uint16_t aConfig); // restarts the filter when it changes
+  inline uint16_t getConfig() { return config; }
+  bool addSample(uint16_t aSample); // true when a new value is out
+  inline uint16_t getValue() { return value; }
+  inline uint8_t getResolution() { return 10 + oversampleExp; } // bits
+
+private:
+  uint16_t median(uint16_t aSample);
+  void reset();
+
+  uint16_t config = 0;
+  uint8_t oversampleExp = 0;
+  uint8_t iirShift = 0;
+  uint8_t medianSize = 1;
+  uint16_t window[DA_FILTER_MEDIAN_MAX];
+  uint8_t windowCount;
+  uint8_t windowIndex;
+  uint32_t accumulator;
+  uint8_t accumulated;
+  int32_t iirState;
+  bool isIIRPrimed;
+  uint16_t value = 0;
+};
+
+#endif // DA_ANALOGFILTER_H
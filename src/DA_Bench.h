@@ -0,0 +1,41 @@
+/**
+ *  @file    DA_Bench.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  loop() stage markers for the simavr benchmark build (SIMAVR_BENCH).
+ *  Each marker is a single OUT to GPIOR0 that tools/simavr-bench watches
+ *  to attribute cycles to the stage that just finished. GPIOR1 is used by
+ *  MgsModbus to bracket a Modbus transaction.
+ *  Compiles to nothing in other builds.
+ *  Keep stage ids in sync with the table in tools/simavr-bench.
+ */
+
+#ifndef DA_BENCH_H
+#define DA_BENCH_H
+
+#define BENCH_LOOP_START 0
+#define BENCH_MODBUS 1
+#define BENCH_LIGHT_CONTROL 2
+#define BENCH_HOST_READS 3
+#define BENCH_HOST_WRITES 4
+#define BENCH_ONE_WIRE 5
+#define BENCH_ANALOGS 6
+#define BENCH_DISCRETE_INPUTS 7
+#define BENCH_TIMERS 8
+#define BENCH_SCD30 9
+#define BENCH_ATLAS 10
+#define BENCH_COMMANDS 11
+#define BENCH_SCHEDULER 12 // DA_TaskScheduler bookkeeping before a task
+
+#if defined(SIMAVR_BENCH)
+#include <avr/io.h>
+#define DA_BENCH_MARK(aStage) (GPIOR0 = (aStage))
+#else
+#define DA_BENCH_MARK(aStage)
+#endif
+
+#endif // DA_BENCH_H
@@ -0,0 +1,35 @@
+/**
+ *  @file    DA_CRC8.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  CRC-8 (Dallas/Maxim, x^8 + x^5 + x^4 + 1, reflected) as used by 1-Wire,
+ *  for the EEPROM records. Bitwise, no table in flash.
+ */
+
+#ifndef DA_CRC8_H
+#define DA_CRC8_H
+#include <Arduino.h>
+
+inline uint8_t daCRC8(const uint8_t *aData, uint8_t aLength) {
+  uint8_t crc = 0;
+
+  while (aLength--) {
+    uint8_t inByte = *aData++;
+
+    for (uint8_t i = 8; i; i--) {
+      uint8_t mix = (crc ^ inByte) & 0x01;
+
+      crc >>= 1;
+      if (mix)
+        crc ^= 0x8C;
+      inByte >>= 1;
+    }
+  }
+  return crc;
+}
+
+#endif // DA_CRC8_H
@@ -0,0 +1,122 @@
+/**
+ *  @file    DA_DiscreteInputScanner.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Port level discrete input scan with vertical counter debounce,
+ *  see DA_DiscreteInputScanner.h
+ **/
+
+#include "DA_DiscreteInputScanner.h"
+#include <Streaming.h>
+
+DA_DiscreteInputScanner::DA_DiscreteInputScanner() {
+  memset(callbacks, 0, sizeof(callbacks));
+}
+
+int8_t DA_DiscreteInputScanner::addInput(uint8_t aPin) {
+  if (channelCount >= DA_DI_MAX_CHANNELS)
+    return -1;
+
+  uint8_t channel = channelCount;
+
+  pinMode(aPin, INPUT);
+  pins[channel] = aPin;
+#if !defined(HOST_BUILD)
+  volatile uint8_t *port = portInputRegister(digitalPinToPort(aPin));
+  uint8_t i = 0;
+
+  while (i < portCount && ports[i] != port)
+    i++;
+  if (i == portCount) {
+    if (portCount >= DA_DI_MAX_PORTS)
+      return -1;
+    ports[portCount++] = port;
+  }
+  portIndex[channel] = i;
+  bitMasks[channel] = digitalPinToBitMask(aPin);
+#endif
+  channelCount++;
+  return channel;
+}
+
+void DA_DiscreteInputScanner::setOnEdgeEvent(uint8_t aChannel, Edge aEdge,
+                                             DA_DIEdgeCallback aCallback) {
+  if (aChannel >= DA_DI_MAX_CHANNELS)
+    return;
+
+  uint16_t bit = 1 << aChannel;
+
+  risingMask &= ~bit;
+  fallingMask &= ~bit;
+  if (aEdge == RisingEdgeDetect)
+    risingMask |= bit;
+  else if (aEdge == FallingEdgeDetect)
+    fallingMask |= bit;
+  callbacks[aChannel] = aCallback;
+}
+
+// all ports are read back to back, then the bits gathered into one word
+uint16_t DA_DiscreteInputScanner::sample() {
+  uint16_t word = 0;
+
+#if defined(HOST_BUILD)
+  for (uint8_t i = 0; i < channelCount; i++)
+    if (digitalRead(pins[i]))
+      word |= 1 << i;
+#else
+  uint8_t portValues[DA_DI_MAX_PORTS];
+
+  for (uint8_t i = 0; i < portCount; i++)
+    portValues[i] = *ports[i];
+  for (uint8_t i = 0; i < channelCount; i++)
+    if (portValues[portIndex[i]] & bitMasks[i])
+      word |= 1 << i;
+#endif
+  return word;
+}
+
+void DA_DiscreteInputScanner::begin() {
+  state = sample();
+  count0 = 0;
+  count1 = 0;
+}
+
+void DA_DiscreteInputScanner::scan() {
+  // counters run only where the sample disagrees with the state and
+  // reset elsewhere, a channel toggles when its counter wraps 3 -> 0
+  uint16_t delta = sample() ^ state;
+
+  count1 = (count1 ^ count0) & delta;
+  count0 = ~count0 & delta;
+
+  uint16_t toggle = delta & ~(count0 | count1);
+
+  scans++;
+  if (!toggle)
+    return;
+
+  state ^= toggle;
+  changes++;
+
+  uint16_t edges =
+      (toggle & state & risingMask) | (toggle & ~state & fallingMask);
+
+  for (uint8_t i = 0; edges; i++, edges >>= 1)
+    if ((edges & 1) && callbacks[i] != NULL)
+      callbacks[i](state >> i & 1, pins[i]);
+}
+
+void DA_DiscreteInputScanner::serialize(Stream *aOutputStream,
+                                        bool includeCR) {
+  *aOutputStream << F("{DI scans:") << scans << F(" changes:") << changes
+                 << F(" channels:") << (int)channelCount << F(" ports:")
+                 << (int)portCount << F(" inputs:") << _HEX(state)
+                 << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,71 @@
+/**
+ *  @file    DA_DiscreteInputScanner.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Batched sampling and debounce of up to 16 discrete inputs.
+ *
+ *  Each scan reads every PINx register the inputs live on once, so all
+ *  channels are sampled at the same instant, and packs the result into one
+ *  word, bit n = channel n. The word is debounced with a 2 bit vertical
+ *  counter (one counter per bit, all 16 updated with a handful of logic
+ *  ops): a channel changes state after DA_DI_DEBOUNCE_SCANS consecutive
+ *  scans that disagree with it, any agreeing scan restarts its count. The
+ *  debounce time is therefore the scan period * DA_DI_DEBOUNCE_SCANS.
+ *
+ *  Rising/falling edge callbacks can be set per channel, they run from
+ *  scan() after the debounced word is updated. The first scan after
+ *  begin() takes the inputs as they are and raises no edges.
+ */
+
+#ifndef DA_DISCRETEINPUTSCANNER_H
+#define DA_DISCRETEINPUTSCANNER_H
+#include <Arduino.h>
+
+#define DA_DI_MAX_CHANNELS 16
+#define DA_DI_MAX_PORTS 4
+#define DA_DI_DEBOUNCE_SCANS 4 // fixed by the 2 bit counter
+
+typedef void (*DA_DIEdgeCallback)(bool aState, int aPin);
+
+class DA_DiscreteInputScanner {
+public:
+  enum Edge { None, RisingEdgeDetect, FallingEdgeDetect };
+
+  DA_DiscreteInputScanner();
+  int8_t addInput(uint8_t aPin); // returns the channel, -1 if full
+  void setOnEdgeEvent(uint8_t aChannel, Edge aEdge,
+                      DA_DIEdgeCallback aCallback);
+  void begin();
+  void scan();
+
+  inline uint16_t getInputs() { return state; } // debounced, packed
+  inline bool getSample(uint8_t aChannel) { return state >> aChannel & 1; }
+  inline uint8_t getChannelCount() { return channelCount; }
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  uint16_t sample();
+
+  uint8_t channelCount = 0;
+  uint8_t pins[DA_DI_MAX_CHANNELS];
+  uint8_t bitMasks[DA_DI_MAX_CHANNELS];
+  uint8_t portIndex[DA_DI_MAX_CHANNELS];
+  DA_DIEdgeCallback callbacks[DA_DI_MAX_CHANNELS];
+  uint8_t portCount = 0;
+  volatile uint8_t *ports[DA_DI_MAX_PORTS];
+
+  uint16_t state = 0;
+  uint16_t count0 = 0; // vertical counter, low bit plane
+  uint16_t count1 = 0; // vertical counter, high bit plane
+  uint16_t risingMask = 0;
+  uint16_t fallingMask = 0;
+  uint32_t scans = 0;
+  uint16_t changes = 0;
+};
+
+#endif // DA_DISCRETEINPUTSCANNER_H
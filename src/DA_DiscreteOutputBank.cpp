@@ -0,0 +1,110 @@
+/**
+ *  @file    DA_DiscreteOutputBank.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Shadow register discrete outputs, see DA_DiscreteOutputBank.h
+ **/
+
+#include "DA_DiscreteOutputBank.h"
+#include <Streaming.h>
+
+#if !defined(HOST_BUILD)
+#include <util/atomic.h>
+
+// same order as daMega2560PinMap
+static volatile uint8_t *const portRegisters[DA_DO_PORT_COUNT] = {
+    &PORTA, &PORTB, &PORTC, &PORTD, &PORTE, &PORTF,
+    &PORTG, &PORTH, &PORTJ, &PORTK, &PORTL};
+static volatile uint8_t *const ddrRegisters[DA_DO_PORT_COUNT] = {
+    &DDRA, &DDRB, &DDRC, &DDRD, &DDRE, &DDRF, &DDRG, &DDRH, &DDRJ, &DDRK, &DDRL};
+#endif
+
+DA_DiscreteOutputBank::DA_DiscreteOutputBank(const DA_DOChannel *aChannels,
+                                             uint8_t aChannelCount)
+    : channels(aChannels),
+      channelCount(min(aChannelCount, (uint8_t)DA_DO_MAX_CHANNELS)) {
+  memset(owned, 0, sizeof(owned));
+  memset(shadow, 0, sizeof(shadow));
+  memset(applied, 0, sizeof(applied));
+}
+
+void DA_DiscreteOutputBank::begin() {
+  for (uint8_t i = 0; i < channelCount; i++)
+    if (channels[i].port != DA_DO_NO_PORT)
+      owned[channels[i].port] |= channels[i].mask;
+
+  memset(shadow, 0, sizeof(shadow));
+#if defined(HOST_BUILD)
+  for (uint8_t i = 0; i < channelCount; i++)
+    if (channels[i].port != DA_DO_NO_PORT) {
+      pinMode(channels[i].pin, OUTPUT);
+      digitalWrite(channels[i].pin, LOW);
+    }
+#else
+  // low before output, the pins come up off
+  for (uint8_t p = 0; p < DA_DO_PORT_COUNT; p++) {
+    if (!owned[p])
+      continue;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      *portRegisters[p] &= ~owned[p];
+      *ddrRegisters[p] |= owned[p];
+    }
+  }
+#endif
+  memset(applied, 0, sizeof(applied));
+}
+
+void DA_DiscreteOutputBank::writeImage(uint32_t aImage, uint32_t aMask) {
+  for (uint8_t i = 0; i < channelCount && aMask; i++) {
+    if (aMask & 1)
+      write(i, aImage & 1);
+    aImage >>= 1;
+    aMask >>= 1;
+  }
+}
+
+uint8_t DA_DiscreteOutputBank::apply() {
+  uint8_t written = 0;
+
+  for (uint8_t p = 0; p < DA_DO_PORT_COUNT; p++) {
+    if (shadow[p] == applied[p])
+      continue;
+#if defined(HOST_BUILD)
+    uint8_t changed = shadow[p] ^ applied[p];
+
+    for (uint8_t i = 0; i < channelCount; i++)
+      if (channels[i].port == p && (changed & channels[i].mask))
+        digitalWrite(channels[i].pin, shadow[p] & channels[i].mask ? HIGH
+                                                                   : LOW);
+#else
+    // other bits of the port may belong to an ISR, keep the RMW atomic
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+      *portRegisters[p] = (*portRegisters[p] & ~owned[p]) | shadow[p];
+    }
+#endif
+    applied[p] = shadow[p];
+    written++;
+  }
+  portWrites += written;
+  return written;
+}
+
+void DA_DiscreteOutputBank::serialize(Stream *aOutputStream,
+                                      bool includeCR) {
+  uint32_t image = 0;
+
+  for (uint8_t i = 0; i < channelCount; i++)
+    if (read(i))
+      image |= (uint32_t)1 << i;
+
+  *aOutputStream << F("{DO channels:") << (int)channelCount
+                 << F(" portWrites:") << portWrites << F(" outputs:")
+                 << _HEX(image) << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,91 @@
+/**
+ *  @file    DA_DiscreteOutputBank.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Discrete outputs driven through a shadow image of each PORTx.
+ *
+ *  Channels are described by a table built at compile time with
+ *  DA_DO_CHANNEL(pin), which resolves the Mega 2560 pin to its port and
+ *  bit mask without the core's PROGMEM lookups. write() only updates the
+ *  shadow image, apply() then does one masked read-modify-write per port
+ *  whose image changed, so outputs on the same port switch together and an
+ *  unchanged image costs a compare per port.
+ *
+ *  Outputs are active high. DA_DO_UNUSED keeps a channel number free
+ *  without claiming a pin. Unlike digitalWrite() nothing turns PWM off,
+ *  so the pins must not be used with analogWrite().
+ */
+
+#ifndef DA_DISCRETEOUTPUTBANK_H
+#define DA_DISCRETEOUTPUTBANK_H
+#include <Arduino.h>
+
+#define DA_DO_MAX_CHANNELS 32
+#define DA_DO_PORT_COUNT 11 // A..L, no I
+#define DA_DO_NO_PORT 0xFF
+
+// Mega 2560 digital pin -> port index (A = 0) << 3 | bit, pins 0..53
+constexpr uint8_t daMega2560PinMap[] = {
+    4 << 3 | 0,  4 << 3 | 1,  4 << 3 | 4,  4 << 3 | 5,  6 << 3 | 5,  // 0-4
+    4 << 3 | 3,  7 << 3 | 3,  7 << 3 | 4,  7 << 3 | 5,  7 << 3 | 6,  // 5-9
+    1 << 3 | 4,  1 << 3 | 5,  1 << 3 | 6,  1 << 3 | 7,  8 << 3 | 1,  // 10-14
+    8 << 3 | 0,  7 << 3 | 1,  7 << 3 | 0,  3 << 3 | 3,  3 << 3 | 2,  // 15-19
+    3 << 3 | 1,  3 << 3 | 0,  0 << 3 | 0,  0 << 3 | 1,  0 << 3 | 2,  // 20-24
+    0 << 3 | 3,  0 << 3 | 4,  0 << 3 | 5,  0 << 3 | 6,  0 << 3 | 7,  // 25-29
+    2 << 3 | 7,  2 << 3 | 6,  2 << 3 | 5,  2 << 3 | 4,  2 << 3 | 3,  // 30-34
+    2 << 3 | 2,  2 << 3 | 1,  2 << 3 | 0,  3 << 3 | 7,  6 << 3 | 2,  // 35-39
+    6 << 3 | 1,  6 << 3 | 0,  10 << 3 | 7, 10 << 3 | 6, 10 << 3 | 5, // 40-44
+    10 << 3 | 4, 10 << 3 | 3, 10 << 3 | 2, 10 << 3 | 1, 10 << 3 | 0, // 45-49
+    1 << 3 | 3,  1 << 3 | 2,  1 << 3 | 1,  1 << 3 | 0};              // 50-53
+
+typedef struct {
+  uint8_t pin;
+  uint8_t port; // index, DA_DO_NO_PORT for an unused channel
+  uint8_t mask;
+} DA_DOChannel;
+
+#define DA_DO_CHANNEL(aPin)                                                    \
+  { (aPin), (uint8_t)(daMega2560PinMap[(aPin)] >> 3),                          \
+    (uint8_t)(1 << (daMega2560PinMap[(aPin)] & 7)) }
+#define DA_DO_UNUSED { 0, DA_DO_NO_PORT, 0 }
+
+class DA_DiscreteOutputBank {
+public:
+  DA_DiscreteOutputBank(const DA_DOChannel *aChannels, uint8_t aChannelCount);
+  void begin(); // outputs off, pins to output
+
+  inline void write(uint8_t aChannel, bool aValue) {
+    const DA_DOChannel &c = channels[aChannel];
+
+    if (c.port == DA_DO_NO_PORT)
+      return;
+    if (aValue)
+      shadow[c.port] |= c.mask;
+    else
+      shadow[c.port] &= ~c.mask;
+  }
+  inline bool read(uint8_t aChannel) {
+    const DA_DOChannel &c = channels[aChannel];
+
+    return c.port != DA_DO_NO_PORT && (shadow[c.port] & c.mask);
+  }
+  // channel n follows bit n of aImage, for the channels in aMask only
+  void writeImage(uint32_t aImage, uint32_t aMask);
+  uint8_t apply(); // returns the number of ports written
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  const DA_DOChannel *channels;
+  uint8_t channelCount;
+  uint8_t owned[DA_DO_PORT_COUNT];   // bits of each port that are ours
+  uint8_t shadow[DA_DO_PORT_COUNT];  // image to drive
+  uint8_t applied[DA_DO_PORT_COUNT]; // image last driven
+  uint32_t portWrites = 0;
+};
+
+#endif // DA_DISCRETEOUTPUTBANK_H
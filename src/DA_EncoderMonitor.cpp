@@ -0,0 +1,78 @@
+/**
+ *  @file    DA_EncoderMonitor.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Encoder velocity and stall/direction faults, see DA_EncoderMonitor.h
+ **/
+
+#include "DA_EncoderMonitor.h"
+#include <Streaming.h>
+
+DA_EncoderMonitor::DA_EncoderMonitor(uint16_t aPeriodMs)
+    : period(aPeriodMs ? aPeriodMs : 1) {}
+
+void DA_EncoderMonitor::reset() {
+  status &= ~DA_ENCODER_FAULTS;
+  stallTicks = 0;
+  wrongCounts = 0;
+}
+
+void DA_EncoderMonitor::step(int32_t aPosition, bool aMotorOn,
+                             bool aDirection) {
+  uint32_t now = micros();
+  uint8_t last = (head + DA_ENCODER_WINDOW - 1) % DA_ENCODER_WINDOW;
+  int32_t delta = samples ? aPosition - positions[last] : 0;
+
+  // head holds the oldest sample once the window has filled
+  if (samples == DA_ENCODER_WINDOW) {
+    uint32_t span = now - stamps[head];
+    float counts = aPosition - positions[head];
+
+    velocity = span ? (int32_t)(counts * 1.0e6 / span) : 0;
+  } else
+    samples++;
+  positions[head] = aPosition;
+  stamps[head] = now;
+  head = (head + 1) % DA_ENCODER_WINDOW;
+
+  if (aMotorOn) {
+    if (delta == 0) {
+      if (stallTicks < 0xFFFF)
+        stallTicks++;
+    } else
+      stallTicks = 0;
+
+    if (delta != 0 && (delta > 0) != aDirection)
+      wrongCounts += delta < 0 ? -delta : delta;
+    else if (delta != 0)
+      wrongCounts = 0;
+  }
+
+  if (!(status & DA_ENCODER_STALL) &&
+      (uint32_t)stallTicks * period >= stallTime) {
+    status |= DA_ENCODER_STALL;
+    faults++;
+  }
+  if (!(status & DA_ENCODER_DIRECTION_MISMATCH) &&
+      wrongCounts > mismatchCounts) {
+    status |= DA_ENCODER_DIRECTION_MISMATCH;
+    faults++;
+  }
+
+  status = (status & DA_ENCODER_FAULTS) | (velocity ? DA_ENCODER_MOVING : 0) |
+           (aMotorOn ? DA_ENCODER_MOTOR_ON : 0);
+}
+
+void DA_EncoderMonitor::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{encoder v:") << velocity << F(" status:0x")
+                 << _HEX(status) << F(" stallTicks:") << stallTicks
+                 << F(" wrongCounts:") << wrongCounts << F(" faults:")
+                 << faults << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
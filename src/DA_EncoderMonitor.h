@@ -0,0 +1,75 @@
+/**
+ *  @file    DA_EncoderMonitor.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Fixed rate velocity estimate and fault detection for a motor with an
+ *  incremental encoder.
+ *
+ *  step() is called every period with the encoder count and the motor
+ *  output as driven. Velocity is the count difference across a window of
+ *  DA_ENCODER_WINDOW periods over the measured time, so quantization noise
+ *  of a single period averages out.
+ *
+ *  Faults latch until reset():
+ *    Stall: the motor has been on for the stall time without a single
+ *    count (jammed winch, broken encoder wire, dead motor).
+ *    Direction mismatch: the counts moved more than the mismatch limit
+ *    against the driven direction while the motor was on (swapped encoder
+ *    channels or direction relay stuck).
+ *  On time is accumulated across relay pulses, so a slow pulsed drive does
+ *  not hide a stall.
+ */
+
+#ifndef DA_ENCODERMONITOR_H
+#define DA_ENCODERMONITOR_H
+#include <Arduino.h>
+
+#define DA_ENCODER_WINDOW 8 // periods
+
+// getStatus() bits
+#define DA_ENCODER_STALL 0x0001
+#define DA_ENCODER_DIRECTION_MISMATCH 0x0002
+#define DA_ENCODER_MOVING 0x0004
+#define DA_ENCODER_MOTOR_ON 0x0008
+#define DA_ENCODER_FAULTS (DA_ENCODER_STALL | DA_ENCODER_DIRECTION_MISMATCH)
+
+class DA_EncoderMonitor {
+public:
+  DA_EncoderMonitor(uint16_t aPeriodMs);
+
+  inline void setStallTime(uint16_t aMs) { stallTime = aMs; }
+  inline void setMismatchCounts(uint16_t aCounts) { mismatchCounts = aCounts; }
+
+  // aDirection true = counting up
+  void step(int32_t aPosition, bool aMotorOn, bool aDirection);
+  void reset(); // clear latched faults
+
+  inline int32_t getVelocity() { return velocity; } // counts/s
+  inline uint16_t getStatus() { return status; }
+  inline bool isFaulted() { return status & DA_ENCODER_FAULTS; }
+  inline uint16_t getFaults() { return faults; } // since boot
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  uint16_t period;
+  uint16_t stallTime = 1000;
+  uint16_t mismatchCounts = 200;
+
+  int32_t positions[DA_ENCODER_WINDOW];
+  uint32_t stamps[DA_ENCODER_WINDOW]; // micros()
+  uint8_t head = 0;
+  uint8_t samples = 0;
+  int32_t velocity = 0;
+
+  uint16_t stallTicks = 0;  // motor on periods without a count
+  uint32_t wrongCounts = 0; // counts against the driven direction
+  uint16_t status = 0;
+  uint16_t faults = 0;
+};
+
+#endif // DA_ENCODERMONITOR_H
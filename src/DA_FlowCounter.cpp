@@ -0,0 +1,89 @@
+/**
+ *  @file    DA_FlowCounter.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Lock free flow meter pulse counting, see DA_FlowCounter.h
+ **/
+
+#include "DA_FlowCounter.h"
+#include <Streaming.h>
+
+#if !defined(HOST_BUILD)
+#include <util/atomic.h>
+#endif
+
+DA_FlowCounter::DA_FlowCounter(uint8_t aPin, uint8_t aPeriodSeconds)
+    : pin(aPin), periodSeconds(aPeriodSeconds) {}
+
+void DA_FlowCounter::begin() {
+  pinMode(pin, INPUT);
+  lastPulses = pulses;
+  periodPulses = 0;
+  frequency = 0;
+  hasLastPulse = false;
+  isTimingPulses = true;
+}
+
+void DA_FlowCounter::sample() {
+  uint16_t current;
+  uint32_t currentMicros;
+
+#if defined(HOST_BUILD)
+  current = pulses;
+  currentMicros = pulseMicros;
+#else
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    current = pulses;
+    currentMicros = pulseMicros;
+  }
+#endif
+  periodPulses = current - lastPulses;
+  lastPulses = current;
+  totalPulses += periodPulses;
+
+  if (!isTimingPulses) {
+    frequency = periodPulses * 1000UL / periodSeconds;
+    if (periodPulses < DA_FLOW_PERIOD_MAX_PULSES / 2) {
+      // stamps start with the next pulse, count until there is one
+      hasLastPulse = false;
+      isTimingPulses = true;
+    }
+    return;
+  }
+
+  if (periodPulses) {
+    uint32_t span = currentMicros - lastPulseMicros;
+
+    if (hasLastPulse && span)
+      frequency = (uint32_t)(periodPulses * 1.0e9 / span);
+    else
+      frequency = periodPulses * 1000UL / periodSeconds;
+    lastPulseMicros = currentMicros;
+    hasLastPulse = true;
+    if (periodPulses > DA_FLOW_PERIOD_MAX_PULSES)
+      isTimingPulses = false;
+  } else if (hasLastPulse) {
+    uint32_t elapsed = micros() - lastPulseMicros;
+
+    if (elapsed > DA_FLOW_ZERO_TIMEOUT) {
+      frequency = 0;
+      hasLastPulse = false;
+    } else if (elapsed && 1.0e9 / elapsed < frequency)
+      frequency = (uint32_t)(1.0e9 / elapsed); // the next pulse is late
+  } else
+    frequency = 0;
+}
+
+void DA_FlowCounter::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{pin:") << (int)pin << F(" period:")
+                 << (int)periodSeconds << F("s pulses:") << periodPulses
+                 << F(" total:") << totalPulses << F(" mHz:") << frequency
+                 << (isTimingPulses ? F(" period") : F(" count")) << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
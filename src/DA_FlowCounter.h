@@ -0,0 +1,68 @@
+/**
+ *  @file    DA_FlowCounter.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Flow meter pulse counting that never stops the interrupt.
+ *
+ *  The pin change ISR only increments a free running counter. Once per
+ *  calculation period sample() copies it with interrupts off for the two
+ *  byte read and subtracts the previous copy, so the interrupt stays
+ *  attached, no pulse falls between two periods and wrap around is
+ *  harmless as long as a period sees fewer than 65536 pulses.
+ *
+ *  At low flow a period holds only a few pulses, so the ISR also stamps
+ *  each pulse with micros() and the frequency comes from the time between
+ *  the last pulses of two samples: n pulses over their exact time span,
+ *  i.e. the averaged pulse period. A period without pulses can only lower
+ *  the estimate (to 1 / time since the last pulse), after
+ *  DA_FLOW_ZERO_TIMEOUT it is 0. Above DA_FLOW_PERIOD_MAX_PULSES per
+ *  period the count alone is accurate enough, the time stamping is turned
+ *  off to keep the ISR short and the frequency is pulses / period. It comes
+ *  back below half that, with hysteresis.
+ */
+
+#ifndef DA_FLOWCOUNTER_H
+#define DA_FLOWCOUNTER_H
+#include <Arduino.h>
+
+#define DA_FLOW_PERIOD_MAX_PULSES 100 // per period, above use counting
+#define DA_FLOW_ZERO_TIMEOUT 10000000UL // us without a pulse means no flow
+
+class DA_FlowCounter {
+public:
+  DA_FlowCounter(uint8_t aPin, uint8_t aPeriodSeconds);
+  virtual void begin(); // the caller attaches handlePulse() to the pin ISR
+  inline void handlePulse() { // ISR
+    pulses++;
+    if (isTimingPulses)
+      pulseMicros = micros();
+  }
+  virtual void sample(); // once per period
+
+  inline uint16_t getCurrentPulses() { return periodPulses; }
+  inline uint32_t getFrequency() { return frequency; } // mHz
+  inline bool isPeriodMode() { return isTimingPulses; }
+  inline uint32_t getTotalPulses() { return totalPulses; }
+  inline uint8_t getPin() { return pin; }
+
+  virtual void serialize(Stream *aOutputStream, bool includeCR);
+
+protected:
+  uint8_t pin;
+  uint8_t periodSeconds;
+  volatile uint16_t pulses = 0; // written by the ISR only
+  volatile uint32_t pulseMicros = 0; // last pulse, written by the ISR
+  volatile bool isTimingPulses = true;
+  bool hasLastPulse = false;
+  uint32_t lastPulseMicros = 0;
+  uint32_t frequency = 0;
+  uint16_t lastPulses = 0;
+  uint16_t periodPulses = 0;
+  uint32_t totalPulses = 0;
+};
+
+#endif // DA_FLOWCOUNTER_H
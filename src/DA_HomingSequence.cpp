@@ -0,0 +1,157 @@
+/**
+ *  @file    DA_HomingSequence.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Homing and multi pass travel calibration, see DA_HomingSequence.h
+ **/
+
+#include "DA_HomingSequence.h"
+#include <Streaming.h>
+
+DA_HomingSequence::DA_HomingSequence(uint16_t aPeriodMs)
+    : period(aPeriodMs ? aPeriodMs : 1) {}
+
+void DA_HomingSequence::start(uint8_t aPasses) {
+  passes = constrain(aPasses, 1, DA_HOMING_MAX_PASSES);
+  pass = 0;
+  error = DA_HOMING_OK;
+  resultReady = false;
+  enter(SeekHome);
+}
+
+void DA_HomingSequence::abort(uint8_t aError) {
+  if (!isActive())
+    return;
+
+  error = aError;
+  enter(Failed);
+}
+
+bool DA_HomingSequence::isResultReady() {
+  bool wasReady = resultReady;
+
+  resultReady = false;
+  return wasReady;
+}
+
+void DA_HomingSequence::enter(State aState) {
+  state = aState;
+  stateTicks = 0;
+  stillTicks = 0;
+}
+
+int8_t DA_HomingSequence::step(int32_t aPosition, bool aAtHome,
+                               bool aIsStopped) {
+  bool isLate = ++stateTicks * period >= timeout;
+
+  if (aPosition != lastPosition)
+    stillTicks = 0;
+  else if (stillTicks < 0xFFFF)
+    stillTicks++;
+  lastPosition = aPosition;
+
+  switch (state) {
+  case SeekHome:
+    if (aAtHome)
+      enter(HomeSettle);
+    else if (isLate) {
+      error = DA_HOMING_HOME_TIMEOUT;
+      enter(Failed);
+    } else
+      return -1;
+    break;
+
+  case HomeSettle:
+    // count from 0 at the switch, the caller zeroes while it is made
+    if (aIsStopped)
+      enter(SeekTop);
+    break;
+
+  case SeekTop:
+    // the end time only runs once the arm has left the switch, the reverse
+    // delay and spin up don't count. A motor that never moves is a stall
+    if (aPosition <= 0)
+      stillTicks = 0;
+    if ((uint32_t)stillTicks * period < endTime) {
+      if (!isLate)
+        return 1;
+      error = DA_HOMING_TOP_TIMEOUT;
+      enter(Failed);
+    } else if (aPosition < (int32_t)minTravel) {
+      error = DA_HOMING_NO_TRAVEL;
+      enter(Failed);
+    } else
+      enter(TopSettle);
+    break;
+
+  case TopSettle:
+    if (!aIsStopped)
+      break;
+
+    travel[pass++] = aPosition;
+    if (pass < passes)
+      enter(SeekHome);
+    else
+      evaluate();
+    break;
+
+  default:
+    break;
+  }
+  return 0;
+}
+
+// median of the passes, mean of the ones within tolerance of it
+void DA_HomingSequence::evaluate() {
+  int32_t sorted[DA_HOMING_MAX_PASSES];
+
+  for (uint8_t i = 0; i < passes; i++) {
+    uint8_t j = i;
+
+    for (; j > 0 && sorted[j - 1] > travel[i]; j--)
+      sorted[j] = sorted[j - 1];
+    sorted[j] = travel[i];
+  }
+
+  int32_t median = sorted[(passes - 1) / 2];
+  int32_t limit = (int64_t)median * tolerance / 1000;
+  int64_t sum = 0;
+  uint8_t kept = 0;
+
+  for (uint8_t i = 0; i < passes; i++) {
+    int32_t deviation = travel[i] - median;
+
+    if (deviation < 0)
+      deviation = -deviation;
+    if (deviation <= limit) {
+      sum += travel[i];
+      kept++;
+    }
+  }
+
+  if (kept * 2 <= passes && passes > 1) {
+    error = DA_HOMING_INCONSISTENT;
+    enter(Failed);
+    return;
+  }
+
+  result = (sum + kept / 2) / kept;
+  resultReady = true;
+  enter(Done);
+}
+
+void DA_HomingSequence::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{homing state:") << (int)state << F(" pass:")
+                 << (int)pass << F("/") << (int)passes << F(" error:")
+                 << (int)error << F(" travel:");
+  for (uint8_t i = 0; i < pass; i++)
+    *aOutputStream << (i ? F(",") : F("")) << travel[i];
+  *aOutputStream << F(" result:") << result << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,89 @@
+/**
+ *  @file    DA_HomingSequence.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Homing and travel calibration for a positioner with a home switch at
+ *  the bottom and a mechanical end stop at the top.
+ *
+ *  step() is called every period and returns the jog direction for the
+ *  motion controller (-1 down, 0 off, +1 up). Each pass jogs down onto
+ *  the home switch, waits for standstill (the caller holds the encoder at
+ *  0 while the switch is made), then jogs up until the counts stop for
+ *  the end time, and records the count at standstill. After all passes
+ *  the counts are sorted, the ones further than the tolerance from the
+ *  median are rejected and the rest averaged, as long as most passes
+ *  agree.
+ *
+ *  getStatus() packs the state (bits 0-3), the completed passes (bits
+ *  4-7) and the last error (bits 8-15) for a status register.
+ */
+
+#ifndef DA_HOMINGSEQUENCE_H
+#define DA_HOMINGSEQUENCE_H
+#include <Arduino.h>
+
+#define DA_HOMING_MAX_PASSES 6
+
+// getError()
+#define DA_HOMING_OK 0
+#define DA_HOMING_ABORTED 1      // abort(), e.g. encoder fault or host lost
+#define DA_HOMING_HOME_TIMEOUT 2 // home switch not reached
+#define DA_HOMING_TOP_TIMEOUT 3  // still counting after the travel timeout
+#define DA_HOMING_NO_TRAVEL 4    // stopped short of the minimum travel
+#define DA_HOMING_INCONSISTENT 5 // most passes outside the tolerance
+
+class DA_HomingSequence {
+public:
+  enum State { Idle, SeekHome, HomeSettle, SeekTop, TopSettle, Done, Failed };
+
+  DA_HomingSequence(uint16_t aPeriodMs);
+
+  void start(uint8_t aPasses);
+  void abort(uint8_t aError = DA_HOMING_ABORTED);
+
+  inline void setEndTime(uint16_t aMs) { endTime = aMs; }
+  inline void setTimeout(uint32_t aMs) { timeout = aMs; }
+  inline void setMinTravel(uint32_t aCounts) { minTravel = aCounts; }
+  inline void setTolerance(uint16_t aPerMille) { tolerance = aPerMille; }
+
+  // aIsStopped: motion controller idle, motor off and standing still
+  int8_t step(int32_t aPosition, bool aAtHome, bool aIsStopped);
+
+  inline bool isActive() { return state > Idle && state < Done; }
+  bool isResultReady(); // true once when a calibration completes
+  inline uint32_t getResult() { return result; }
+  inline State getState() { return state; }
+  inline uint8_t getError() { return error; }
+  inline uint16_t getStatus() {
+    return (uint16_t)error << 8 | (pass & 0x0F) << 4 | (state & 0x0F);
+  }
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  void enter(State aState);
+  void evaluate();
+
+  uint16_t period;
+  uint16_t endTime = 500;   // ms without counts at the top end stop
+  uint32_t timeout = 60000; // ms per leg
+  uint32_t minTravel = 1000;
+  uint16_t tolerance = 10; // per mille of the median
+
+  State state = Idle;
+  uint8_t passes = 0;
+  uint8_t pass = 0; // completed
+  int32_t travel[DA_HOMING_MAX_PASSES];
+  uint32_t stateTicks = 0;
+  uint16_t stillTicks = 0; // periods without a count
+  int32_t lastPosition = 0;
+  uint32_t result = 0;
+  bool resultReady = false;
+  uint8_t error = DA_HOMING_OK;
+};
+
+#endif // DA_HOMINGSEQUENCE_H
@@ -0,0 +1,118 @@
+/**
+ *  @file    DA_Logger.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Ring buffered serial debug log, see DA_Logger.h
+ **/
+
+#include "DA_Logger.h"
+#include <Streaming.h>
+#include <stdarg.h>
+
+static const char levelTags[] = "EWID";
+
+DA_Logger::DA_Logger(HardwareSerial &aPort) : port(aPort) {}
+
+void DA_Logger::log(uint8_t aLevel, PGM_P aFormat, ...) {
+  if (aLevel > level)
+    return;
+  // finish a partial Stream line first
+  if (lineLength)
+    commitLine();
+
+  va_list args;
+  int prefix = snprintf_P(line, DA_LOG_LINE_SIZE, PSTR("%lu %c "),
+                          (unsigned long)millis(), levelTags[aLevel & 0x03]);
+
+  va_start(args, aFormat);
+  vsnprintf_P(line + prefix, DA_LOG_LINE_SIZE - prefix, aFormat, args);
+  va_end(args);
+  lineLength = strlen(line);
+  commitLine();
+}
+
+bool DA_Logger::isDue(uint32_t &aLast, uint16_t aIntervalMs) {
+  uint32_t stamp = millis() + 1; // 0 is never logged
+
+  if (aLast && stamp - aLast < aIntervalMs) {
+    suppressed++;
+    return false;
+  }
+  aLast = stamp ? stamp : 1;
+  return true;
+}
+
+size_t DA_Logger::write(uint8_t aByte) {
+  if (aByte == '\n')
+    commitLine();
+  else if (aByte != '\r') {
+    if (lineLength >= DA_LOG_LINE_SIZE)
+      commitLine();
+    line[lineLength++] = aByte;
+  }
+  return 1;
+}
+
+void DA_Logger::put(const char *aText, uint8_t aLength) {
+  for (uint8_t i = 0; i < aLength; i++) {
+    ring[head] = aText[i];
+    head = (head + 1) & (DA_LOG_BUFFER_SIZE - 1);
+  }
+}
+
+// the line plus CR LF, all or nothing. Lost lines are noted ahead of the
+// next one that fits along with the note
+void DA_Logger::commitLine() {
+  char note[24];
+  uint8_t noteLength = 0;
+
+  if (dropped != reportedDrops)
+    noteLength = snprintf_P(note, sizeof(note), PSTR("... %u dropped\r\n"),
+                            (unsigned)(dropped - reportedDrops));
+
+  line[lineLength++] = '\r';
+  line[lineLength++] = '\n';
+  if (DA_LOG_BUFFER_SIZE - 1 - used() < noteLength + lineLength)
+    dropped++;
+  else {
+    put(note, noteLength);
+    put(line, lineLength);
+    reportedDrops = dropped;
+    lines++;
+  }
+  lineLength = 0;
+
+  if (used() > highWater)
+    highWater = used();
+}
+
+void DA_Logger::drain() {
+  int room = port.availableForWrite();
+
+  while (room-- > 0 && tail != head) {
+    port.write((uint8_t)ring[tail]);
+    tail = (tail + 1) & (DA_LOG_BUFFER_SIZE - 1);
+  }
+}
+
+void DA_Logger::flush() {
+  while (tail != head) {
+    port.write((uint8_t)ring[tail]);
+    tail = (tail + 1) & (DA_LOG_BUFFER_SIZE - 1);
+  }
+  port.flush();
+}
+
+void DA_Logger::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{log level:") << (int)level << F(" lines:") << lines
+                 << F(" dropped:") << dropped << F(" suppressed:")
+                 << suppressed << F(" used:") << used() << F(" highWater:")
+                 << highWater << F("/") << DA_LOG_BUFFER_SIZE << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
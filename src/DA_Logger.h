@@ -0,0 +1,90 @@
+/**
+ *  @file    DA_Logger.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Non blocking debug log for a serial port.
+ *
+ *  Lines are staged in a RAM ring and drain() hands the port only what
+ *  its TX buffer has room for, so logging never waits on the baud rate.
+ *  The UART's own TX interrupt (HardwareSerial) then sends them. A line
+ *  that does not fit the ring is dropped whole and counted, the next line
+ *  that fits is preceded by a "dropped" note.
+ *
+ *  log() / DA_LOG() format with a PROGMEM format string and prefix the
+ *  line with millis() and the level. DA_LOG_EVERY() rate limits one call
+ *  site. The logger is also a Stream, so serialize(&logger, ...) and
+ *  Streaming output land in the ring, one line per '\n'.
+ *
+ *  No %f on AVR, log floats scaled to integers.
+ */
+
+#ifndef DA_LOGGER_H
+#define DA_LOGGER_H
+#include <Arduino.h>
+
+#define DA_LOG_BUFFER_SIZE 256 // power of 2
+#define DA_LOG_LINE_SIZE 96    // longer lines are split
+
+#define DA_LOG_ERROR 0
+#define DA_LOG_WARN 1
+#define DA_LOG_INFO 2
+#define DA_LOG_DEBUG 3
+
+#define DA_LOG(aLogger, aLevel, aFormat, ...)                                  \
+  (aLogger).log(aLevel, PSTR(aFormat), ##__VA_ARGS__)
+
+// at most one line per aIntervalMs from this call site
+#define DA_LOG_EVERY(aLogger, aIntervalMs, aLevel, aFormat, ...)               \
+  do {                                                                         \
+    static uint32_t daLogLast = 0;                                             \
+    if ((aLogger).isDue(daLogLast, aIntervalMs))                               \
+      DA_LOG(aLogger, aLevel, aFormat, ##__VA_ARGS__);                         \
+  } while (0)
+
+class DA_Logger : public Stream {
+public:
+  DA_Logger(HardwareSerial &aPort);
+
+  void log(uint8_t aLevel, PGM_P aFormat, ...);
+  bool isDue(uint32_t &aLast, uint16_t aIntervalMs);
+  void drain(); // non blocking, call periodically
+  void flush(); // blocking, before a reboot
+
+  inline void setLevel(uint8_t aLevel) { level = aLevel; }
+  inline uint8_t getLevel() { return level; }
+  inline uint16_t getDropped() { return dropped; }
+
+  // Stream, output only
+  size_t write(uint8_t aByte);
+  int available() { return 0; }
+  int read() { return -1; }
+  int peek() { return -1; }
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  void commitLine();
+  void put(const char *aText, uint8_t aLength);
+  inline uint16_t used() { return (head - tail) & (DA_LOG_BUFFER_SIZE - 1); }
+
+  HardwareSerial &port;
+  uint8_t level = DA_LOG_INFO;
+
+  char ring[DA_LOG_BUFFER_SIZE];
+  uint16_t head = 0; // next write
+  uint16_t tail = 0; // next drain
+  char line[DA_LOG_LINE_SIZE + 2]; // + CR LF
+  uint8_t lineLength = 0;
+
+  uint16_t lines = 0;
+  uint16_t dropped = 0;
+  uint16_t reportedDrops = 0;
+  uint16_t suppressed = 0; // by DA_LOG_EVERY
+  uint16_t highWater = 0;  // ring bytes
+};
+
+#endif // DA_LOGGER_H
@@ -0,0 +1,172 @@
+/**
+ *  @file    DA_MotionController.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Trapezoidal pulsed drive position controller, see DA_MotionController.h
+ **/
+
+#include "DA_MotionController.h"
+#include <Streaming.h>
+
+DA_MotionController::DA_MotionController(uint16_t aPeriodMs)
+    : period(aPeriodMs ? aPeriodMs : 1) {}
+
+void DA_MotionController::setTarget(int32_t aTarget) {
+  target = aTarget;
+  hasTarget = true;
+  if (state == Jogging)
+    jog(0);
+}
+
+void DA_MotionController::jog(int8_t aDirection) {
+  hasTarget = false;
+  jogDirection = aDirection;
+  if (aDirection == 0 && state == Jogging) {
+    isMotorOn = false;
+    stopTicks = 0;
+    state = Stopping;
+  }
+}
+
+void DA_MotionController::stop() {
+  hasTarget = false;
+  jogDirection = 0;
+  if (isMotorOn) {
+    isMotorOn = false;
+    stopTicks = 0;
+    state = Stopping;
+  }
+}
+
+bool DA_MotionController::isSettled() {
+  bool wasSettled = settled;
+
+  settled = false;
+  return wasSettled;
+}
+
+// counts/s over the last period, lightly smoothed
+void DA_MotionController::estimateVelocity(int32_t aPosition) {
+  uint32_t now = micros();
+
+  if (isPositionValid && now != lastMicros) {
+    int32_t raw = (int32_t)((float)(aPosition - lastPosition) * 1.0e6 /
+                            (uint32_t)(now - lastMicros));
+
+    velocity = (velocity + raw) / 2;
+  }
+  lastPosition = aPosition;
+  lastMicros = now;
+  isPositionValid = true;
+}
+
+// trapezoid: ramp up from the start, ramp down across the slowdown zone
+uint8_t DA_MotionController::computeDrive(uint32_t aDistance) {
+  uint32_t up = 100;
+  uint32_t down = 100;
+
+  if (rampTime && moveTicks * period < rampTime)
+    up = moveTicks * period * 100UL / rampTime;
+  if (slowdownZone && aDistance < slowdownZone)
+    down = aDistance * 100UL / slowdownZone;
+
+  uint32_t result = up < down ? up : down;
+
+  return result < minDrive ? minDrive : result;
+}
+
+bool DA_MotionController::startMove(bool aDirection) {
+  // reversing: the motor has to be off for the reverse delay first
+  if (aDirection != direction && (uint32_t)stopTicks * period < reverseDelay)
+    return false;
+
+  direction = aDirection;
+  moveTicks = 0;
+  pulseTicks = 0;
+  return true;
+}
+
+void DA_MotionController::step(int32_t aPosition) {
+  position = aPosition;
+  estimateVelocity(aPosition);
+  if (!isMotorOn && stopTicks < 0xFFFF)
+    stopTicks++;
+
+  int32_t distance = target - position;
+  uint32_t absDistance = distance < 0 ? -distance : distance;
+  uint32_t absVelocity = velocity < 0 ? -velocity : velocity;
+  uint32_t coast = absVelocity * coastTime / 1000UL;
+
+  switch (state) {
+  case Idle:
+    drive = 0;
+    if (jogDirection) {
+      if (startMove(jogDirection > 0))
+        state = Jogging;
+    } else if (hasTarget && absDistance > deadband) {
+      if (startMove(distance > 0))
+        state = Moving;
+    }
+    break;
+
+  case Jogging:
+    if (!jogDirection || (jogDirection > 0) != direction) {
+      isMotorOn = false;
+      stopTicks = 0;
+      state = Stopping;
+      break;
+    }
+    drive = 100;
+    isMotorOn = true;
+    break;
+
+  case Moving:
+    if (!hasTarget || (distance > 0) != direction ||
+        absDistance <= deadband + coast) {
+      // at (or coasting into) the target, or overshot: cut the motor
+      isMotorOn = false;
+      stopTicks = 0;
+      state = Stopping;
+      break;
+    }
+
+    drive = computeDrive(absDistance);
+    isMotorOn = (uint32_t)pulseTicks * period * 100UL <
+                (uint32_t)drive * pulseWindow;
+    if (++pulseTicks * period >= pulseWindow)
+      pulseTicks = 0;
+    moveTicks++;
+    break;
+
+  case Stopping:
+    drive = 0;
+    isMotorOn = false;
+    // wait for standstill, or twice the coast time at most
+    if (velocity != 0 && (uint32_t)stopTicks * period < 2UL * coastTime)
+      break;
+
+    state = Idle;
+    if (hasTarget) {
+      lastError = distance;
+      moves++;
+      // outside the deadband the next step starts a correction move
+      settled = absDistance <= deadband;
+    }
+    break;
+  }
+}
+
+void DA_MotionController::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{motion state:") << (int)state << F(" pos:")
+                 << position << F(" target:") << target << F(" v:")
+                 << velocity << F(" drive:") << (int)drive << F(" dir:")
+                 << direction << F(" on:") << isMotorOn << F(" moves:")
+                 << moves << F(" lastError:") << lastError << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
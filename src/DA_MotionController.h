@@ -0,0 +1,91 @@
+/**
+ *  @file    DA_MotionController.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Fixed rate position controller for a relay driven motor with an
+ *  incremental encoder (direction relay + motor on relay).
+ *
+ *  step() is called every period with the encoder count. A move follows a
+ *  trapezoidal drive profile: the drive ramps up over the ramp time and
+ *  ramps down across the slowdown zone before the target, never below the
+ *  minimum drive. A relay cannot be PWM'd, so drive < 100 % is a slow
+ *  pulsed drive, on for drive % of each pulse window. The motor is cut
+ *  early by the distance it coasts at the measured velocity (anticipation)
+ *  and the move ends once it stands still inside the deadband. Reversing
+ *  waits for the reverse delay with the motor off.
+ *
+ *  Positions and distances are in encoder counts, + is counting up.
+ */
+
+#ifndef DA_MOTIONCONTROLLER_H
+#define DA_MOTIONCONTROLLER_H
+#include <Arduino.h>
+
+class DA_MotionController {
+public:
+  enum State { Idle, Moving, Stopping, Jogging };
+
+  DA_MotionController(uint16_t aPeriodMs);
+  void setTarget(int32_t aTarget);
+  void jog(int8_t aDirection); // manual full drive -1, 0 = off, +1
+  void stop();                 // motor off, forget the target
+
+  inline void setDeadband(uint16_t aCounts) { deadband = aCounts; }
+  inline void setSlowdownZone(uint16_t aCounts) { slowdownZone = aCounts; }
+  inline void setRampTime(uint16_t aMs) { rampTime = aMs; }
+  inline void setCoastTime(uint16_t aMs) { coastTime = aMs; }
+  inline void setReverseDelay(uint16_t aMs) { reverseDelay = aMs; }
+  inline void setPulseWindow(uint16_t aMs) { pulseWindow = aMs; }
+  inline void setMinDrive(uint8_t aPercent) { minDrive = aPercent; }
+
+  void step(int32_t aPosition); // once per period
+
+  inline bool getDirection() { return direction; } // true = counting up
+  inline bool getMotorOn() { return isMotorOn; }
+  inline State getState() { return state; }
+  inline int32_t getTarget() { return target; }
+  inline int32_t getVelocity() { return velocity; } // counts/s
+  inline uint8_t getDrive() { return drive; }       // %
+  bool isSettled(); // true once after each completed move
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  uint8_t computeDrive(uint32_t aDistance);
+  void estimateVelocity(int32_t aPosition);
+  bool startMove(bool aDirection);
+
+  uint16_t period;
+  uint16_t deadband = 50;
+  uint16_t slowdownZone = 1000;
+  uint16_t rampTime = 1000;
+  uint16_t coastTime = 150;
+  uint16_t reverseDelay = 300;
+  uint16_t pulseWindow = 500;
+  uint8_t minDrive = 20;
+
+  State state = Idle;
+  int32_t target = 0;
+  bool hasTarget = false;
+  int8_t jogDirection = 0;
+  int32_t position = 0;
+  int32_t lastPosition = 0;
+  uint32_t lastMicros = 0;
+  bool isPositionValid = false;
+  int32_t velocity = 0;
+  bool direction = false;
+  bool isMotorOn = false;
+  uint8_t drive = 0;
+  uint32_t moveTicks = 0;  // periods since the move started
+  uint32_t stopTicks = 0;  // periods since the motor went off
+  uint16_t pulseTicks = 0; // position in the pulse window
+  bool settled = false;
+  uint16_t moves = 0;
+  int32_t lastError = 0; // counts off target when the last move ended
+};
+
+#endif // DA_MOTIONCONTROLLER_H
@@ -0,0 +1,448 @@
+/**
+ *  @file    DA_OneWireTemperatureMgr.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Incremental DS18x20 reads, see DA_OneWireTemperatureMgr.h
+ **/
+
+#include "DA_OneWireTemperatureMgr.h"
+#include <Streaming.h>
+
+#define DS18X20_CONVERT_T 0x44
+#define DS18X20_READ_SCRATCHPAD 0xBE
+#define DS18X20_READ_POWER_SUPPLY 0xB4
+#define DS18S20_FAMILY 0x10 // 9 bit, 0.5 C per count
+
+static bool isTemperatureFamily(uint8_t aFamily) {
+  return aFamily == DS18S20_FAMILY || aFamily == 0x22 || aFamily == 0x28 ||
+         aFamily == 0x3B;
+}
+
+// blank (all 0) and erased (all 1) EEPROM are not
+static bool isValidROM(const uint8_t *aROM) {
+  return aROM[0] && OneWire::crc8(aROM, 7) == aROM[7];
+}
+
+static void printROM(Stream *aOutputStream, const uint8_t *aROM) {
+  for (uint8_t i = 0; i < 8; i++)
+    *aOutputStream << (aROM[i] < 0x10 ? "0" : "") << _HEX(aROM[i]);
+}
+
+DA_OneWireTemperatureMgr::DA_OneWireTemperatureMgr() { resetMaps(); }
+
+int8_t DA_OneWireTemperatureMgr::addBus(uint8_t aPin) {
+  if (busCount >= DA_MAX_ONE_WIRE_BUSES)
+    return -1;
+
+  DA_OneWireBus &bus = buses[busCount];
+
+  bus.wire.begin(aPin);
+  bus.pin = aPin;
+  bus.state = Idle;
+  bus.slot = 0;
+  bus.attempts = 0;
+  bus.isParasite = false;
+  bus.isFirstPoll = true;
+  bus.isDiscoveryRequested = true;
+  bus.discoveryStart = bus.pollStart = millis();
+  bus.seen = 0;
+  bus.cycles = 0;
+  bus.discoveries = 0;
+  return busCount++;
+}
+
+void DA_OneWireTemperatureMgr::requestDiscovery() {
+  for (uint8_t i = 0; i < busCount; i++)
+    buses[i].isDiscoveryRequested = true;
+}
+
+void DA_OneWireTemperatureMgr::scanSensors() {
+  bool isBusy;
+
+  requestDiscovery();
+  // conversions or read cycles in progress finish first
+  do {
+    refresh();
+    isBusy = false;
+    for (uint8_t i = 0; i < busCount; i++)
+      isBusy |= buses[i].state != Idle || buses[i].isDiscoveryRequested;
+  } while (isBusy);
+}
+
+void DA_OneWireTemperatureMgr::refresh() {
+  // waiting buses cost a read time slot at most, the first one with a
+  // transaction to do ends the call
+  for (uint8_t i = 0; i < busCount; i++) {
+    unsigned long stepStart = micros();
+    uint8_t bus = nextBus;
+
+    if (++nextBus >= busCount)
+      nextBus = 0;
+    if (step(bus)) {
+      unsigned long elapsed = micros() - stepStart;
+      if (elapsed > maxStepMicros)
+        maxStepMicros = min(elapsed, 0xFFFFUL);
+      return;
+    }
+  }
+}
+
+// true if a bus transaction was done
+bool DA_OneWireTemperatureMgr::step(uint8_t aBus) {
+  DA_OneWireBus &bus = buses[aBus];
+  bool hasDevices = false;
+
+  switch (bus.state) {
+  case Idle:
+    // discovery only between read cycles, the bus resets would be harmless
+    // but the cycle would take longer
+    if (bus.isDiscoveryRequested ||
+        (discoveryInterval &&
+         millis() - bus.discoveryStart >= discoveryInterval)) {
+      startDiscovery(bus);
+      discoverNext(aBus);
+      return true;
+    }
+    for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++)
+      hasDevices |= sensors[i].isPresent && sensors[i].bus == aBus;
+    if (!hasDevices ||
+        (!bus.isFirstPoll && millis() - bus.pollStart < pollingInterval))
+      return false;
+    bus.isFirstPoll = false;
+    bus.pollStart = millis();
+    startConversion(bus);
+    return true;
+
+  case Converting:
+    if (isConversionDone(bus)) {
+      if (bus.isParasite)
+        bus.wire.depower();
+      bus.slot = 0;
+      bus.state = Reading;
+    }
+    return false;
+
+  case Reading:
+    if (bus.attempts &&
+        millis() - bus.retryStart <
+            (uint32_t)DA_ONE_WIRE_RETRY_BACKOFF << (bus.attempts - 1))
+      return false;
+    if (readNextSlot(aBus))
+      return true;
+    bus.cycles++;
+    bus.state = Idle;
+    if (onPoll != NULL)
+      onPoll();
+    return false;
+
+  case Discovering:
+    discoverNext(aBus);
+    return true;
+  }
+  return false;
+}
+
+void DA_OneWireTemperatureMgr::startDiscovery(DA_OneWireBus &aBus) {
+  aBus.isDiscoveryRequested = false;
+  aBus.discoveryStart = millis();
+  aBus.seen = 0;
+  aBus.wire.reset_search();
+  aBus.state = Discovering;
+}
+
+// one search, one device. false from search() ends the pass
+void DA_OneWireTemperatureMgr::discoverNext(uint8_t aBus) {
+  uint8_t rom[8];
+
+  if (!buses[aBus].wire.search(rom)) {
+    finishDiscovery(aBus);
+    return;
+  }
+  if (OneWire::crc8(rom, 7) == rom[7] && isTemperatureFamily(rom[0]))
+    matchDevice(aBus, rom);
+}
+
+void DA_OneWireTemperatureMgr::matchDevice(uint8_t aBus, const uint8_t *aROM) {
+  int8_t slot = -1;
+
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
+    if (!memcmp(oneWireSlotROMs[i], aROM, 8)) {
+      slot = i;
+      break;
+    }
+    if (slot < 0 && !isValidROM(oneWireSlotROMs[i]))
+      slot = i; // first empty one, unless the ROM has a slot further on
+  }
+  if (slot < 0) {
+    overflows++;
+    return;
+  }
+
+  DA_OneWireSensor &sensor = sensors[slot];
+
+  if (memcmp(oneWireSlotROMs[slot], aROM, 8)) {
+    memcpy(oneWireSlotROMs[slot], aROM, 8);
+    memset(&sensor, 0, sizeof(sensor));
+    sensor.quality = DA_ONE_WIRE_NO_DATA;
+    if (onMap != NULL)
+      onMap();
+  }
+  if (!sensor.isPresent) {
+    sensor.isPresent = true;
+    presentCount++;
+    changes++;
+  }
+  sensor.bus = aBus; // a probe moved to another bus follows
+  sensor.unseen = 0;
+  buses[aBus].seen |= 1UL << slot;
+}
+
+void DA_OneWireTemperatureMgr::finishDiscovery(uint8_t aBus) {
+  DA_OneWireBus &bus = buses[aBus];
+  uint16_t lastChanges = changes;
+  bool hasDevices = false;
+
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
+    DA_OneWireSensor &sensor = sensors[i];
+
+    // one missed search could be noise, DA_ONE_WIRE_DISCOVERY_MISSES not
+    if (!sensor.isPresent || sensor.bus != aBus || (bus.seen & 1UL << i) ||
+        ++sensor.unseen < DA_ONE_WIRE_DISCOVERY_MISSES) {
+      hasDevices |= sensor.isPresent && sensor.bus == aBus;
+      continue;
+    }
+    sensor.isPresent = false;
+    sensor.quality = DA_ONE_WIRE_MISSING;
+    presentCount--;
+    changes++;
+  }
+
+  // a parasite powered sensor pulls the bus low in this time slot
+  if (changes != lastChanges || !bus.discoveries) {
+    bus.isParasite = false;
+    if (hasDevices && bus.wire.reset()) {
+      bus.wire.skip();
+      bus.wire.write(DS18X20_READ_POWER_SUPPLY);
+      bus.isParasite = !bus.wire.read_bit();
+    }
+  }
+  bus.discoveries++;
+  bus.state = Idle;
+}
+
+void DA_OneWireTemperatureMgr::startConversion(DA_OneWireBus &aBus) {
+  aBus.wire.reset();
+  aBus.wire.skip();
+  // parasite sensors need the strong pull up for the whole conversion
+  aBus.wire.write(DS18X20_CONVERT_T, aBus.isParasite);
+  aBus.conversionStart = millis();
+  aBus.state = Converting;
+}
+
+bool DA_OneWireTemperatureMgr::isConversionDone(DA_OneWireBus &aBus) {
+  if (millis() - aBus.conversionStart >= DA_DS18B20_CONVERSION_TIME)
+    return true;
+  // externally powered sensors answer 1 once every conversion is done
+  return !aBus.isParasite && aBus.wire.read_bit();
+}
+
+// reads the next enabled slot on this bus, or retries the current one.
+// false once the cycle is complete
+bool DA_OneWireTemperatureMgr::readNextSlot(uint8_t aBus) {
+  DA_OneWireBus &bus = buses[aBus];
+
+  for (; bus.slot < DA_MAX_ONE_WIRE_SENSORS; bus.slot++) {
+    DA_OneWireSensor &sensor = sensors[bus.slot];
+
+    // retries belong to this slot, a slot disabled, remapped or gone
+    // mid retry must not hand them to the next one
+    if (!isEnabled(bus.slot) || !sensor.isPresent || sensor.bus != aBus) {
+      bus.attempts = 0;
+      continue;
+    }
+
+    uint8_t result = readScratchpad(bus, bus.slot);
+
+    reads++;
+    if (result == DA_ONE_WIRE_GOOD)
+      sensor.failures = 0;
+    else {
+      if (result == DA_ONE_WIRE_CRC_ERROR)
+        crcErrors++;
+      else
+        missingReads++;
+      if (++bus.attempts <= DA_ONE_WIRE_RETRIES) {
+        retries++;
+        bus.retryStart = millis();
+        return true;
+      }
+      if (sensor.failures < 0xFF)
+        sensor.failures++;
+    }
+    sensor.quality = result;
+    bus.attempts = 0;
+    bus.slot++;
+    return true;
+  }
+  return false;
+}
+
+// DA_ONE_WIRE_GOOD and the new temperature, or the failure
+uint8_t DA_OneWireTemperatureMgr::readScratchpad(DA_OneWireBus &aBus,
+                                                 uint8_t aSlot) {
+  uint8_t data[9];
+  uint8_t allOr = 0;
+  uint8_t allAnd = 0xFF;
+
+  if (!aBus.wire.reset())
+    return DA_ONE_WIRE_MISSING;
+  aBus.wire.select(oneWireSlotROMs[aSlot]);
+  aBus.wire.write(DS18X20_READ_SCRATCHPAD);
+  aBus.wire.read_bytes(data, sizeof(data));
+
+  for (uint8_t i = 0; i < sizeof(data); i++) {
+    allOr |= data[i];
+    allAnd &= data[i];
+  }
+  if (allAnd == 0xFF) // nobody drove the bus
+    return DA_ONE_WIRE_MISSING;
+  if (!allOr || OneWire::crc8(data, 8) != data[8])
+    return DA_ONE_WIRE_CRC_ERROR;
+
+  int16_t raw = (int16_t)(data[1] << 8 | data[0]);
+  if (oneWireSlotROMs[aSlot][0] == DS18S20_FAMILY)
+    raw <<= 3; // to 1/16 C
+  sensors[aSlot].temperature = raw;
+  return DA_ONE_WIRE_GOOD;
+}
+
+float DA_OneWireTemperatureMgr::getTemperature(uint8_t aSlot) {
+  if (aSlot >= DA_MAX_ONE_WIRE_SENSORS || !isValidROM(oneWireSlotROMs[aSlot]) ||
+      !isFound(aSlot))
+    return DA_ONE_WIRE_NO_TEMPERATURE;
+  return sensors[aSlot].temperature / 16.0;
+}
+
+int16_t DA_OneWireTemperatureMgr::getTemperatureX10(uint8_t aSlot) {
+  if (aSlot >= DA_MAX_ONE_WIRE_SENSORS || !isValidROM(oneWireSlotROMs[aSlot]) ||
+      !isFound(aSlot))
+    return (int16_t)(DA_ONE_WIRE_NO_TEMPERATURE * 10);
+  // truncates like (int)(getTemperature() * 10.0)
+  return (int32_t)sensors[aSlot].temperature * 10 / 16;
+}
+
+uint16_t DA_OneWireTemperatureMgr::getQuality(uint8_t aSlot) {
+  if (aSlot >= DA_MAX_ONE_WIRE_SENSORS || !isValidROM(oneWireSlotROMs[aSlot]))
+    return DA_ONE_WIRE_NO_DATA;
+  if (!isFound(aSlot)) // never found since boot
+    return DA_ONE_WIRE_MISSING;
+  if (!isEnabled(aSlot))
+    return DA_ONE_WIRE_DISABLED;
+
+  DA_OneWireSensor &sensor = sensors[aSlot];
+  return (uint16_t)sensor.failures << 8 | sensor.quality;
+}
+
+uint64_t DA_OneWireTemperatureMgr::getUIID(uint8_t aSlot) {
+  uint64_t rom = 0;
+
+  if (aSlot >= DA_MAX_ONE_WIRE_SENSORS || !isValidROM(oneWireSlotROMs[aSlot]))
+    return 0;
+  // bytes as the bus sends them, family code in the low byte
+  memcpy(&rom, oneWireSlotROMs[aSlot], sizeof(rom));
+  return rom;
+}
+
+bool DA_OneWireTemperatureMgr::mapSensor(uint8_t aSlot, uint8_t aFromSlot) {
+  uint8_t rom[8];
+
+  if (aFromSlot >= DA_MAX_ONE_WIRE_SENSORS)
+    return false;
+  memcpy(rom, oneWireSlotROMs[aFromSlot], sizeof(rom));
+  return mapSensorROM(aSlot, rom);
+}
+
+bool DA_OneWireTemperatureMgr::mapSensorROM(uint8_t aSlot,
+                                            const uint8_t *aROM) {
+  uint8_t rom[8];
+  DA_OneWireSensor sensor;
+
+  if (aSlot >= DA_MAX_ONE_WIRE_SENSORS || !isValidROM(aROM))
+    return false;
+  memcpy(rom, aROM, sizeof(rom)); // may point into oneWireSlotROMs
+
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
+    if (i == aSlot || memcmp(oneWireSlotROMs[i], rom, 8))
+      continue;
+    // swap, the state follows its probe
+    memcpy(oneWireSlotROMs[i], oneWireSlotROMs[aSlot], 8);
+    memcpy(oneWireSlotROMs[aSlot], rom, 8);
+    sensor = sensors[i];
+    sensors[i] = sensors[aSlot];
+    sensors[aSlot] = sensor;
+    return true;
+  }
+  if (!memcmp(oneWireSlotROMs[aSlot], rom, 8))
+    return true;
+
+  // a probe in no slot, the one there is found again by discovery
+  if (sensors[aSlot].isPresent) {
+    presentCount--;
+    changes++;
+  }
+  memcpy(oneWireSlotROMs[aSlot], rom, 8);
+  memset(&sensors[aSlot], 0, sizeof(DA_OneWireSensor));
+  sensors[aSlot].quality = DA_ONE_WIRE_NO_DATA;
+  return true;
+}
+
+void DA_OneWireTemperatureMgr::resetMaps() {
+  memset(oneWireSlotROMs, 0, sizeof(oneWireSlotROMs));
+  memset(sensors, 0, sizeof(sensors));
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++)
+    sensors[i].quality = DA_ONE_WIRE_NO_DATA;
+  presentCount = 0;
+}
+
+void DA_OneWireTemperatureMgr::serialize(Stream *aOutputStream,
+                                         bool includeCR) {
+  *aOutputStream << F("{1-Wire buses:") << (int)busCount << F(" devices:")
+                 << (int)presentCount << F(" changes:") << changes
+                 << F(" overflows:") << overflows << F(" reads:") << reads
+                 << F(" crc:") << crcErrors << F(" missing:") << missingReads
+                 << F(" retries:") << retries << F(" maxStepMicros:")
+                 << maxStepMicros << endl;
+
+  for (uint8_t i = 0; i < busCount; i++) {
+    DA_OneWireBus &bus = buses[i];
+
+    *aOutputStream << F(" bus:") << i << F(" pin:") << bus.pin
+                   << F(" state:") << bus.state << F(" parasite:")
+                   << bus.isParasite << F(" cycles:") << bus.cycles
+                   << F(" discoveries:") << bus.discoveries << endl;
+  }
+
+  // empty slots are left out, 1wire m <slot> <slot> moves a probe
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
+    DA_OneWireSensor &sensor = sensors[i];
+
+    if (!isValidROM(oneWireSlotROMs[i]))
+      continue;
+    *aOutputStream << F(" slot:") << i << F(" enabled:") << isEnabled(i)
+                   << F(" quality:") << _HEX(getQuality(i)) << F(" rom:");
+    printROM(aOutputStream, oneWireSlotROMs[i]);
+    if (isFound(i))
+      *aOutputStream << F(" bus:") << sensor.bus << F(" present:")
+                     << sensor.isPresent << F(" temp*10:")
+                     << getTemperatureX10(i);
+    *aOutputStream << endl;
+  }
+  *aOutputStream << F("}");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
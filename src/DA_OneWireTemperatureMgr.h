@@ -0,0 +1,183 @@
+/**
+ *  @file    DA_OneWireTemperatureMgr.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  DS18x20 temperatures on up to DA_MAX_ONE_WIRE_BUSES 1-Wire buses, read
+ *  a step at a time.
+ *
+ *  Each bus (addBus()) runs its own pipeline: every polling interval one
+ *  skip ROM CONVERT T starts all its sensors at once, then it polls for the
+ *  end of the conversion (a read time slot, or the full conversion time on
+ *  a parasite powered bus) and reads the scratchpad of one enabled slot per
+ *  turn. refresh() gives the buses turns round robin and does at most one
+ *  bus transaction per call, so a call never costs more than one reset +
+ *  match ROM + 9 byte read (~11 ms of bit banging) however many sensors
+ *  there are, while the conversions of all buses overlap. The poll callback
+ *  runs after the last slot of each bus cycle.
+ *
+ *  Every scratchpad is checked with OneWire::crc8. A read with no presence
+ *  pulse or all 1s is a missing device, a CRC mismatch (or all 0s, a
+ *  shorted bus) a CRC error. Either is retried up to DA_ONE_WIRE_RETRIES
+ *  times on later turns, DA_ONE_WIRE_RETRY_BACKOFF ms apart doubling each
+ *  time, the scratchpad keeps the converted value meanwhile. The last good
+ *  temperature is held through failures, getQuality() tells the host how
+ *  much to trust it: the DA_ONE_WIRE_* code of the last read in the low
+ *  byte, the consecutive failed reads (saturating) in the high byte.
+ *
+ *  Slots are what the host sees (HR_TI_00x, HR_TI_BLOCK). Each is keyed by
+ *  the ROM code of its probe, oneWireSlotROMs[slot], the only copy of it,
+ *  and sensors[slot] holds the probe's runtime state, so search order and
+ *  bus never move a probe to another slot.
+ *
+ *  Devices are found in the background: every discovery interval, or on
+ *  requestDiscovery(), one OneWire::search() (one branch of the ROM tree,
+ *  one device) runs per turn between the bus's read cycles. A found ROM
+ *  goes back to its slot, on whichever bus it turns up, a new one takes
+ *  the first empty slot and the map callback is told to persist the ROMs.
+ *  With every slot taken it is only counted (overflows), slots of absent
+ *  probes are kept for them. A device not found by
+ *  DA_ONE_WIRE_DISCOVERY_MISSES passes of its bus in a row is marked absent
+ *  (quality missing, value held, no more reads). Every addition and removal
+ *  bumps getChanges().
+ */
+
+#ifndef DA_ONEWIRETEMPERATUREMGR_H
+#define DA_ONEWIRETEMPERATUREMGR_H
+#include <Arduino.h>
+#include <OneWire.h>
+
+// ~45 bytes of RAM per bus, 15 per slot (ROM and state) plus 6 MbData
+// words per slot in HR_TI_BLOCK
+#define DA_MAX_ONE_WIRE_BUSES 4
+#define DA_MAX_ONE_WIRE_SENSORS 32 // slots, 32 at most (masks)
+#define DA_DS18B20_CONVERSION_TIME 750 // ms, 12 bit resolution
+#define DA_ONE_WIRE_NO_TEMPERATURE -127.0 // unmapped slot
+#define DA_ONE_WIRE_RETRIES 3
+#define DA_ONE_WIRE_RETRY_BACKOFF 20 // ms, doubles per retry
+#define DA_ONE_WIRE_DISCOVERY_MISSES 2 // passes before a device is absent
+
+// getQuality() low byte
+#define DA_ONE_WIRE_GOOD 0
+#define DA_ONE_WIRE_CRC_ERROR 1 // value held
+#define DA_ONE_WIRE_MISSING 2   // value held
+#define DA_ONE_WIRE_NO_DATA 3   // no sensor in the slot or no good read yet
+#define DA_ONE_WIRE_DISABLED 4
+
+// runtime state of the probe in a slot
+typedef struct {
+  uint8_t bus;         // found on
+  bool isPresent;      // found by the last discovery of its bus
+  uint8_t unseen;      // discovery passes missed in a row
+  int16_t temperature; // 1/16 C, last good read
+  uint8_t failures;    // consecutive failed reads, saturates
+  uint8_t quality;     // DA_ONE_WIRE_*, NO_DATA until found and read
+} DA_OneWireSensor;
+
+// one bus pipeline
+typedef struct {
+  OneWire wire;
+  uint8_t pin;
+  uint8_t state;    // DA_OneWireTemperatureMgr::State
+  uint8_t slot;     // next slot to read
+  uint8_t attempts; // failed reads of this slot so far
+  bool isParasite;
+  bool isFirstPoll;
+  bool isDiscoveryRequested;
+  uint32_t retryStart;
+  uint32_t pollStart;
+  uint32_t conversionStart;
+  uint32_t discoveryStart;
+  uint32_t seen; // slot bits found by this discovery
+  uint16_t cycles;
+  uint16_t discoveries;
+} DA_OneWireBus;
+
+typedef void (*DA_OneWirePollCallback)();
+typedef void (*DA_OneWireMapCallback)();
+
+class DA_OneWireTemperatureMgr {
+public:
+  enum State { Idle, Converting, Reading, Discovering };
+
+  DA_OneWireTemperatureMgr();
+  int8_t addBus(uint8_t aPin); // returns the bus, -1 if full
+
+  void scanSensors(); // blocking discovery of every bus, for setup()
+  void refresh();     // at most one bus transaction, call often
+  void requestDiscovery();
+
+  inline void setPollingInterval(uint32_t aMs) { pollingInterval = aMs; }
+  inline void setDiscoveryInterval(uint32_t aMs) { discoveryInterval = aMs; }
+  inline void setOnPollCallBack(DA_OneWirePollCallback aCallback) {
+    onPoll = aCallback;
+  }
+  inline void setOnMapCallBack(DA_OneWireMapCallback aCallback) {
+    onMap = aCallback;
+  }
+  inline void setEnabled(bool aEnabled, uint8_t aSlot) {
+    if (aSlot < DA_MAX_ONE_WIRE_SENSORS)
+      enabledMask = aEnabled ? enabledMask | 1UL << aSlot
+                             : enabledMask & ~(1UL << aSlot);
+  }
+  inline uint8_t getBusCount() { return busCount; }
+  inline uint8_t getDeviceCount() { return presentCount; }
+  inline uint16_t getChanges() { return changes; } // added + removed, wraps
+
+  float getTemperature(uint8_t aSlot);      // last good value
+  int16_t getTemperatureX10(uint8_t aSlot); // same, no float math
+  uint16_t getQuality(uint8_t aSlot);
+  uint64_t getUIID(uint8_t aSlot); // slot ROM code, 0 if empty
+
+  // the probe moves to aSlot, the one there (if any) to its old slot. A
+  // ROM in no slot replaces the probe there, found again if present
+  bool mapSensor(uint8_t aSlot, uint8_t aFromSlot);
+  bool mapSensorROM(uint8_t aSlot, const uint8_t *aROM);
+  void resetMaps();
+  uint8_t oneWireSlotROMs[DA_MAX_ONE_WIRE_SENSORS][8]; // persisted
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  bool step(uint8_t aBus);
+  void startConversion(DA_OneWireBus &aBus);
+  bool isConversionDone(DA_OneWireBus &aBus);
+  bool readNextSlot(uint8_t aBus);
+  uint8_t readScratchpad(DA_OneWireBus &aBus, uint8_t aSlot);
+  void startDiscovery(DA_OneWireBus &aBus);
+  void discoverNext(uint8_t aBus);
+  void matchDevice(uint8_t aBus, const uint8_t *aROM);
+  void finishDiscovery(uint8_t aBus);
+  // found since boot, or since the slot was mapped
+  inline bool isFound(uint8_t aSlot) {
+    return sensors[aSlot].isPresent ||
+           sensors[aSlot].quality != DA_ONE_WIRE_NO_DATA;
+  }
+  inline bool isEnabled(uint8_t aSlot) { return enabledMask >> aSlot & 1; }
+
+  DA_OneWireBus buses[DA_MAX_ONE_WIRE_BUSES];
+  uint8_t busCount = 0;
+  uint8_t nextBus = 0; // round robin
+
+  DA_OneWireSensor sensors[DA_MAX_ONE_WIRE_SENSORS]; // by slot
+  uint32_t enabledMask = 0xFFFFFFFFUL;
+  uint8_t presentCount = 0;
+
+  uint32_t pollingInterval = DA_DS18B20_CONVERSION_TIME;
+  uint32_t discoveryInterval = 0;
+  DA_OneWirePollCallback onPoll = NULL;
+  DA_OneWireMapCallback onMap = NULL;
+
+  uint16_t changes = 0;
+  uint16_t overflows = 0; // new devices with no empty slot
+  uint32_t reads = 0;      // per attempt, retries included
+  uint16_t crcErrors = 0;  // per attempt
+  uint16_t missingReads = 0;
+  uint16_t retries = 0;
+  uint16_t maxStepMicros = 0;
+};
+
+#endif // DA_ONEWIRETEMPERATUREMGR_H
@@ -0,0 +1,49 @@
+/**
+ *  @file    DA_PositionJournal.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Background written position journal, see DA_PositionJournal.h
+ **/
+
+#include "DA_PositionJournal.h"
+#include <Streaming.h>
+
+static_assert(sizeof(DA_JournalRecord) <= DA_RECORD_RING_MAX_SIZE,
+              "DA_JournalRecord too big for DA_RecordRing");
+
+DA_PositionJournal::DA_PositionJournal(uint16_t aEEPROMAddress,
+                                       uint8_t aSlotCount)
+    : ring(aEEPROMAddress, aSlotCount, sizeof(DA_JournalRecord),
+           offsetof(DA_JournalRecord, crc)) {}
+
+bool DA_PositionJournal::load(int32_t &aPosition, uint32_t &aMaxPulses) {
+  DA_JournalRecord entry;
+
+  if (!ring.load(&entry) || entry.maxPulses == 0)
+    return false;
+  aPosition = entry.position;
+  aMaxPulses = entry.maxPulses;
+  return true;
+}
+
+void DA_PositionJournal::append(int32_t aPosition, uint32_t aMaxPulses) {
+  DA_JournalRecord entry;
+
+  memset(&entry, 0, sizeof(entry)); // host padding
+  entry.position = aPosition;
+  entry.maxPulses = aMaxPulses;
+  ring.append(&entry);
+}
+
+void DA_PositionJournal::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{journal ");
+  ring.serialize(aOutputStream);
+  *aOutputStream << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,50 @@
+/**
+ *  @file    DA_PositionJournal.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Append only EEPROM journal for a positioner's encoder count and
+ *  calibrated travel, written in the background.
+ *
+ *  Records go round a DA_RecordRing: append() stages, service() writes a
+ *  byte per loop() pass, a torn record falls back to the one before. A
+ *  record with no travel is never valid.
+ */
+
+#ifndef DA_POSITIONJOURNAL_H
+#define DA_POSITIONJOURNAL_H
+#include "DA_RecordRing.h"
+#include <Arduino.h>
+
+typedef struct {
+  uint16_t sequence;
+  int32_t position;   // encoder count
+  uint32_t maxPulses; // calibrated travel
+  uint8_t crc;        // CRC-8 (Dallas/Maxim) of the bytes above
+} DA_JournalRecord;
+
+class DA_PositionJournal {
+public:
+  DA_PositionJournal(uint16_t aEEPROMAddress, uint8_t aSlotCount);
+  // newest valid record, false if none or a record is still being written
+  bool load(int32_t &aPosition, uint32_t &aMaxPulses);
+  void append(int32_t aPosition, uint32_t aMaxPulses);
+  inline void service() { ring.service(); } // call every loop() pass
+  inline void flush() { ring.flush(); }     // blocking, before a reboot
+
+  inline bool isBusy() { return ring.isBusy(); }
+  inline uint16_t getSequence() { return ring.getSequence(); }
+  inline static uint16_t getSize(uint8_t aSlotCount) {
+    return aSlotCount * sizeof(DA_JournalRecord);
+  }
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  DA_RecordRing ring;
+};
+
+#endif // DA_POSITIONJOURNAL_H
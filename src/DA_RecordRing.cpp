@@ -0,0 +1,110 @@
+/**
+ *  @file    DA_RecordRing.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Background written EEPROM record ring, see DA_RecordRing.h
+ **/
+
+#include "DA_RecordRing.h"
+#include "DA_CRC8.h"
+#include <EEPROM.h>
+#include <Streaming.h>
+
+#if !defined(HOST_BUILD)
+#include <avr/eeprom.h>
+#endif
+
+DA_RecordRing::DA_RecordRing(uint16_t aEEPROMAddress, uint8_t aSlotCount,
+                             uint8_t aRecordSize, uint8_t aCRCOffset)
+    : address(aEEPROMAddress), slotCount(aSlotCount),
+      recordSize(min(aRecordSize, (uint8_t)DA_RECORD_RING_MAX_SIZE)),
+      crcOffset(aCRCOffset) {
+  slot = aSlotCount - 1; // the first record goes to slot 0
+}
+
+bool DA_RecordRing::load(void *aRecord) {
+  uint8_t entry[DA_RECORD_RING_MAX_SIZE];
+  bool isFound = false;
+
+  // slot and sequence belong to the record being written
+  if (isBusy())
+    return false;
+
+  for (uint8_t i = 0; i < slotCount; i++) {
+    uint8_t allOr = 0;
+    uint16_t entrySequence;
+
+    for (uint8_t j = 0; j < recordSize; j++)
+      allOr |= entry[j] = EEPROM.read(slotAddress(i) + j);
+    if (!allOr || entry[crcOffset] != daCRC8(entry, crcOffset))
+      continue;
+    memcpy(&entrySequence, entry, sizeof(entrySequence));
+    if (isFound && (int16_t)(entrySequence - sequence) <= 0)
+      continue;
+
+    isFound = true;
+    slot = i;
+    sequence = entrySequence;
+    memcpy(aRecord, entry, recordSize);
+  }
+  return isFound;
+}
+
+void DA_RecordRing::append(const void *aRecord) {
+  if (isQueued)
+    replaced++;
+  memcpy(queued, aRecord, recordSize);
+  isQueued = true;
+  appends++;
+  if (!isWriting)
+    startRecord();
+}
+
+void DA_RecordRing::startRecord() {
+  if (++slot >= slotCount)
+    slot = 0;
+  ++sequence;
+  memcpy(record, queued, recordSize);
+  memcpy(record, &sequence, sizeof(sequence));
+  record[crcOffset] = daCRC8(record, crcOffset);
+  writeIndex = 0;
+  isWriting = true;
+  isQueued = false;
+}
+
+void DA_RecordRing::service() {
+  if (!isWriting)
+    return;
+#if !defined(HOST_BUILD)
+  // the previous byte is still being programmed
+  if (!eeprom_is_ready())
+    return;
+#endif
+
+  // update() skips bytes that already hold the value, no wear, no wait
+  EEPROM.update(slotAddress(slot) + writeIndex, record[writeIndex]);
+  bytesWritten++;
+
+  if (++writeIndex < recordSize)
+    return;
+
+  isWriting = false;
+  if (isQueued)
+    startRecord();
+}
+
+void DA_RecordRing::flush() {
+  while (isBusy())
+    service();
+}
+
+void DA_RecordRing::serialize(Stream *aOutputStream) {
+  *aOutputStream << F("slot:") << (int)slot << F("/") << (int)slotCount
+                 << F(" sequence:") << sequence << F(" appends:") << appends
+                 << F(" replaced:") << replaced << F(" bytes:")
+                 << bytesWritten << F(" busy:") << isBusy();
+}
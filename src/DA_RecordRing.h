@@ -0,0 +1,74 @@
+/**
+ *  @file    DA_RecordRing.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Ring of fixed size EEPROM records written in the background, shared by
+ *  DA_PositionJournal and DA_TotalizerStore.
+ *
+ *  A record starts with a uint16_t sequence number and has a CRC-8 byte
+ *  at aCRCOffset covering the bytes before it, the ring fills in both.
+ *  append() only stages the record. service(), called every loop() pass,
+ *  writes one byte whenever the EEPROM is idle, so the ~3.3 ms of each
+ *  byte write runs in the EEPROM hardware instead of blocking loop(). A
+ *  record appended while another is being written replaces any record
+ *  still waiting, only the newest matters.
+ *
+ *  Each record goes to the slot after the previous one, spreading the
+ *  wear, with the CRC written last, so a record torn by a power loss fails
+ *  the CRC and load() falls back to the one before. load() picks the valid
+ *  slot with the newest sequence number (serial number arithmetic, the
+ *  ring holds far fewer than 32768 slots). An all zero slot passes the CRC
+ *  and is skipped.
+ */
+
+#ifndef DA_RECORDRING_H
+#define DA_RECORDRING_H
+#include <Arduino.h>
+
+#define DA_RECORD_RING_MAX_SIZE 16 // bytes, host padding included
+
+class DA_RecordRing {
+public:
+  DA_RecordRing(uint16_t aEEPROMAddress, uint8_t aSlotCount,
+                uint8_t aRecordSize, uint8_t aCRCOffset);
+  // newest valid record, false if none or a record is still being written
+  bool load(void *aRecord);
+  void append(const void *aRecord);
+  void service(); // at most one byte, call every loop() pass
+  void flush();   // finish pending writes, blocking (before a reboot)
+
+  inline bool isBusy() { return isWriting || isQueued; }
+  inline uint16_t getSequence() { return sequence; }
+  inline uint16_t getAppends() { return appends; }
+
+  void serialize(Stream *aOutputStream);
+
+private:
+  void startRecord();
+  inline uint16_t slotAddress(uint8_t aSlot) {
+    return address + aSlot * recordSize;
+  }
+
+  uint16_t address;
+  uint8_t slotCount;
+  uint8_t recordSize;
+  uint8_t crcOffset;
+  uint8_t slot;          // last written
+  uint16_t sequence = 0; // of the last record started
+
+  uint8_t record[DA_RECORD_RING_MAX_SIZE]; // being written
+  uint8_t queued[DA_RECORD_RING_MAX_SIZE];
+  uint8_t writeIndex = 0; // next byte of record
+  bool isWriting = false;
+  bool isQueued = false;
+
+  uint16_t appends = 0;  // since boot
+  uint16_t replaced = 0; // queued records overwritten before written
+  uint16_t bytesWritten = 0;
+};
+
+#endif // DA_RECORDRING_H
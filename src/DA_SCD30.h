@@ -64,6 +64,9 @@ public:
     return curTemperature;
   }
 
+  // read now, for callers that do their own timing (timer wheel)
+  inline void poll() { onRefresh(); }
+
   void startContiousMeasurement();
   void stopContiousMeasurement();
   // void receiveRaw( char* aResult );
@@ -0,0 +1,189 @@
+/**
+ *  @file    DA_TaskScheduler.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Cooperative scheduler for loop(), see DA_TaskScheduler.h
+ **/
+
+#include "DA_TaskScheduler.h"
+#include "DA_Bench.h"
+#include <Streaming.h>
+
+DA_TaskScheduler::DA_TaskScheduler(DA_TimerWheel &aWheel) : wheel(aWheel) {}
+
+int8_t DA_TaskScheduler::addTask(DA_TaskCallback aCallback, uint32_t aPeriod,
+                                 uint8_t aPriority, uint16_t aBudget,
+                                 const __FlashStringHelper *aName) {
+  if (taskCount >= DA_MAX_TASKS || aCallback == NULL)
+    return DA_INVALID_TASK;
+
+  int8_t id = taskCount;
+  DA_Task &task = tasks[id];
+
+  task.callback = aCallback;
+  task.name = aName;
+  task.scheduler = this;
+  task.timer.pprev = NULL;
+  task.timer.next = NULL;
+  task.period = aPeriod;
+  task.budget = aBudget;
+  task.priority = aPriority;
+  task.enabled = true;
+  task.overdue = false;
+  task.runs = 0;
+  task.overruns = 0;
+  task.lates = 0;
+  task.maxMicros = 0;
+
+  // keep order[] sorted by priority, equal priorities in order of adding
+  uint8_t i = taskCount;
+  while (i > 0 && tasks[order[i - 1]].priority > aPriority) {
+    order[i] = order[i - 1];
+    i--;
+  }
+  order[i] = id;
+  taskCount++;
+
+  // ranks moved, carry the ready bits over and rebuild the masks
+  uint16_t ready = 0;
+  everyPassMask = 0;
+  for (uint8_t rank = 0; rank < taskCount; rank++) {
+    DA_Task &other = tasks[order[rank]];
+
+    if (&other != &task && (readyMask & bit(other.rank)))
+      ready |= bit(rank);
+    if (other.enabled && other.period == DA_TASK_EVERY_PASS)
+      everyPassMask |= bit(rank);
+    other.rank = rank;
+  }
+  readyMask = ready;
+
+  arm(task);
+  return id;
+}
+
+void DA_TaskScheduler::arm(DA_Task &aTask) {
+  if (aTask.enabled && aTask.period != DA_TASK_EVERY_PASS)
+    wheel.start(aTask.timer, 0, aTask.period, onTaskDue, &aTask);
+  else
+    wheel.stop(aTask.timer);
+}
+
+void DA_TaskScheduler::onTaskDue(void *aContext) {
+  DA_Task &task = *(DA_Task *)aContext;
+  uint16_t taskBit = bit(task.rank);
+
+  if (task.scheduler->readyMask & taskBit) {
+    task.lates++;
+    task.overdue = true;
+  }
+  task.scheduler->readyMask |= taskBit;
+}
+
+void DA_TaskScheduler::setEnabled(int8_t aTaskId, bool aEnabled) {
+  if (aTaskId < 0 || aTaskId >= taskCount)
+    return;
+
+  DA_Task &task = tasks[aTaskId];
+  uint16_t taskBit = bit(task.rank);
+
+  task.enabled = aEnabled;
+  readyMask &= ~taskBit;
+  if (aEnabled && task.period == DA_TASK_EVERY_PASS)
+    everyPassMask |= taskBit;
+  else
+    everyPassMask &= ~taskBit;
+  arm(task);
+}
+
+void DA_TaskScheduler::setPeriod(int8_t aTaskId, uint32_t aPeriod) {
+  if (aTaskId < 0 || aTaskId >= taskCount)
+    return;
+
+  tasks[aTaskId].period = aPeriod;
+  setEnabled(aTaskId, tasks[aTaskId].enabled);
+}
+
+void DA_TaskScheduler::runTask(DA_Task &aTask) {
+  DA_BENCH_MARK(BENCH_SCHEDULER);
+  unsigned long start = micros();
+
+  aTask.callback();
+
+  unsigned long elapsed = micros() - start;
+  aTask.runs++;
+  if (elapsed > aTask.budget)
+    aTask.overruns++;
+  if (elapsed > aTask.maxMicros)
+    aTask.maxMicros = min(elapsed, 0xFFFFUL);
+}
+
+void DA_TaskScheduler::run() {
+  unsigned long passStart = micros();
+  bool ranPeriodic = false;
+  uint16_t mask;
+
+  wheel.service();
+  DA_BENCH_MARK(BENCH_TIMERS);
+
+  for (mask = everyPassMask; mask; mask &= mask - 1)
+    runTask(tasks[order[__builtin_ctz(mask)]]);
+
+  for (mask = readyMask; mask; mask &= mask - 1) {
+    uint8_t rank = __builtin_ctz(mask);
+    DA_Task &task = tasks[order[rank]];
+
+    // the highest priority ready task always runs, the rest only while
+    // their budget still fits in this pass. Overdue tasks run anyway so
+    // busy high priorities cannot starve them
+    if (ranPeriodic && !task.overdue &&
+        micros() - passStart + task.budget > passBudget)
+      continue;
+
+    readyMask &= ~bit(rank);
+    task.overdue = false;
+    runTask(task);
+    ranPeriodic = true;
+  }
+
+  unsigned long elapsed = micros() - passStart;
+  passes++;
+  if (elapsed > maxPassMicros)
+    maxPassMicros = min(elapsed, 0xFFFFUL);
+}
+
+void DA_TaskScheduler::resetStats() {
+  for (uint8_t i = 0; i < taskCount; i++) {
+    tasks[i].runs = 0;
+    tasks[i].overruns = 0;
+    tasks[i].lates = 0;
+    tasks[i].maxMicros = 0;
+  }
+  passes = 0;
+  maxPassMicros = 0;
+}
+
+void DA_TaskScheduler::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{passes:") << passes << F(" maxPassMicros:")
+                 << maxPassMicros << F(" passBudget:") << passBudget;
+
+  for (uint8_t i = 0; i < taskCount; i++) {
+    DA_Task &task = tasks[order[i]];
+
+    *aOutputStream << endl
+                   << F(" {") << task.name << F(" period:") << task.period
+                   << F(" priority:") << (int)task.priority << F(" budget:")
+                   << task.budget << F(" enabled:") << task.enabled
+                   << F(" runs:") << task.runs << F(" overruns:")
+                   << task.overruns << F(" lates:") << task.lates
+                   << F(" maxMicros:") << task.maxMicros << F("}");
+  }
+  *aOutputStream << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
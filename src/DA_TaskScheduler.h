@@ -0,0 +1,89 @@
+/**
+ *  @file    DA_TaskScheduler.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Small cooperative scheduler for loop().
+ *
+ *  Each subsystem registers a callback with a period (ms), a priority
+ *  (0 = highest) and a CPU budget (us). Tasks with a period of 0 are
+ *  serviced on every pass (network). Periodic tasks are timers on the
+ *  DA_TimerWheel that only mark the task ready, so a pass costs one wheel
+ *  slot check rather than a millis() compare per task. Each pass then runs
+ *  the ready tasks in priority order whose budgets still fit in the pass
+ *  budget, so a pass - and with it the Modbus response time - stays bounded.
+ *  A task still waiting when its timer fires again is counted late and runs
+ *  regardless of budget. A task that runs longer than its budget is counted
+ *  as an overrun.
+ */
+
+#ifndef DA_TASKSCHEDULER_H
+#define DA_TASKSCHEDULER_H
+#include <Arduino.h>
+#include "DA_TimerWheel.h"
+
+#define DA_MAX_TASKS 16 // one bit per task in the ready masks
+#define DA_TASK_EVERY_PASS 0             // period for tasks run on every pass
+#define DA_DEFAULT_PASS_BUDGET_US 2000   // us of periodic work per pass
+#define DA_INVALID_TASK -1
+
+typedef void (*DA_TaskCallback)();
+
+class DA_TaskScheduler;
+
+struct _DA_Task {
+  DA_TaskCallback callback;
+  const __FlashStringHelper *name;
+  DA_TaskScheduler *scheduler;
+  DA_WheelTimer timer;
+  uint32_t period;        // ms
+  uint16_t budget;        // us
+  uint8_t priority;       // 0 = highest
+  uint8_t rank;           // position in priority order, bit in the masks
+  bool enabled;
+  bool overdue;           // timer fired again before the task ran
+  uint32_t runs;
+  uint16_t overruns;      // ran longer than budget
+  uint16_t lates;         // missed a whole period
+  uint16_t maxMicros;     // longest run
+};
+
+typedef _DA_Task DA_Task;
+
+class DA_TaskScheduler {
+public:
+  DA_TaskScheduler(DA_TimerWheel &aWheel);
+  int8_t addTask(DA_TaskCallback aCallback, uint32_t aPeriod,
+                 uint8_t aPriority, uint16_t aBudget,
+                 const __FlashStringHelper *aName);
+  void setEnabled(int8_t aTaskId, bool aEnabled);
+  void setPeriod(int8_t aTaskId, uint32_t aPeriod);
+  inline void setPassBudget(uint16_t aBudget) { passBudget = aBudget; }
+
+  void run(); // one scheduling pass, call from loop()
+
+  inline uint8_t getTaskCount() { return taskCount; }
+  inline uint32_t getPasses() { return passes; }
+  void resetStats();
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  static void onTaskDue(void *aContext);
+  void arm(DA_Task &aTask);
+  void runTask(DA_Task &aTask);
+
+  DA_TimerWheel &wheel;
+  DA_Task tasks[DA_MAX_TASKS];
+  uint8_t order[DA_MAX_TASKS]; // task ids sorted by priority
+  uint8_t taskCount = 0;
+  uint16_t readyMask = 0;      // by rank, periodic tasks due
+  uint16_t everyPassMask = 0;  // by rank, enabled every pass tasks
+  uint16_t passBudget = DA_DEFAULT_PASS_BUDGET_US;
+  uint32_t passes = 0;
+  uint16_t maxPassMicros = 0;
+};
+
+#endif // DA_TASKSCHEDULER_H
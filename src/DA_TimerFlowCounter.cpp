@@ -0,0 +1,96 @@
+/**
+ *  @file    DA_TimerFlowCounter.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Hardware timer flow pulse counting, see DA_TimerFlowCounter.h
+ **/
+
+#include "DA_TimerFlowCounter.h"
+#include <Streaming.h>
+
+#if !defined(HOST_BUILD)
+#include <util/atomic.h>
+#endif
+
+DA_TimerFlowCounter::DA_TimerFlowCounter(uint8_t aTimer,
+                                         uint8_t aPeriodSeconds)
+    : DA_FlowCounter(aTimer == 5 ? DA_FLOW_T5_PIN : DA_FLOW_NO_PIN,
+                     aPeriodSeconds),
+      timer(aTimer) {}
+
+void DA_TimerFlowCounter::begin() {
+#if !defined(HOST_BUILD)
+  // normal mode, clocked by rising edges on Tn, no interrupts
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if (timer == 5) {
+      DDRL &= ~_BV(PL2);
+      TCCR5A = 0;
+      TIMSK5 = 0;
+      TCNT5 = 0;
+      TCCR5B = _BV(CS52) | _BV(CS51) | _BV(CS50);
+    } else {
+      DDRH &= ~_BV(PH7);
+      TCCR4A = 0;
+      TIMSK4 = 0;
+      TCNT4 = 0;
+      TCCR4B = _BV(CS42) | _BV(CS41) | _BV(CS40);
+    }
+  }
+#endif
+  isTimingPulses = false; // no time stamps without a pulse interrupt
+  lastPulses = readCounter();
+  lastSampleMicros = micros();
+  periodPulses = 0;
+  frequency = 0;
+}
+
+uint16_t DA_TimerFlowCounter::readCounter() {
+#if defined(HOST_BUILD)
+  return pulses; // no timers on the host, handlePulse() drives the count
+#else
+  uint16_t count;
+
+  // TCNTn reads go through the TEMP register shared by all 16 bit timers
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { count = timer == 5 ? TCNT5 : TCNT4; }
+  return count;
+#endif
+}
+
+void DA_TimerFlowCounter::sample() {
+  uint16_t current;
+  uint32_t now;
+
+#if defined(HOST_BUILD)
+  current = readCounter();
+  now = micros();
+#else
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    current = readCounter();
+    now = micros();
+  }
+#endif
+  uint32_t span = now - lastSampleMicros;
+
+  periodPulses = current - lastPulses;
+  lastPulses = current;
+  lastSampleMicros = now;
+  totalPulses += periodPulses;
+
+  float mHz = span ? periodPulses * 1.0e9 / span : 0.0;
+
+  frequency = mHz < 4.0e9 ? (uint32_t)mHz : 4000000000UL;
+}
+
+void DA_TimerFlowCounter::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{timer:") << (int)timer << F(" period:")
+                 << (int)periodSeconds << F("s pulses:") << periodPulses
+                 << F(" total:") << totalPulses << F(" mHz:") << frequency
+                 << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
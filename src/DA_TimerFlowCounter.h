@@ -0,0 +1,44 @@
+/**
+ *  @file    DA_TimerFlowCounter.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Flow meter pulses counted by a 16 bit timer clocked from its external
+ *  clock input, no interrupt per pulse.
+ *
+ *  Timer5 counts rising edges on T5 (PL2, pin 47), Timer4 on T4 (PH7, not
+ *  routed to a Mega pin number). The pulse input is synchronised to the
+ *  CPU clock, so rates up to ~6 MHz are counted at no CPU cost. sample()
+ *  reads TCNTn together with micros() and the frequency is the count
+ *  difference over the exact time between the two reads. A period must
+ *  see fewer than 65536 pulses.
+ *
+ *  The timer's PWM outputs are lost (Timer5: pins 44-46, Timer4: pins
+ *  6-8), they are only used as plain digital outputs here.
+ */
+
+#ifndef DA_TIMERFLOWCOUNTER_H
+#define DA_TIMERFLOWCOUNTER_H
+#include "DA_FlowCounter.h"
+
+#define DA_FLOW_T5_PIN 47
+#define DA_FLOW_NO_PIN 0xFF
+
+class DA_TimerFlowCounter : public DA_FlowCounter {
+public:
+  DA_TimerFlowCounter(uint8_t aTimer, uint8_t aPeriodSeconds); // 4 or 5
+  virtual void begin();
+  virtual void sample();
+  virtual void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  uint16_t readCounter();
+
+  uint8_t timer;
+  uint32_t lastSampleMicros = 0;
+};
+
+#endif // DA_TIMERFLOWCOUNTER_H
@@ -0,0 +1,156 @@
+/**
+ *  @file    DA_TimerWheel.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Hierarchical timer wheel driven by a Timer2 1 ms tick,
+ *  see DA_TimerWheel.h
+ **/
+
+#include "DA_TimerWheel.h"
+
+#define L0_MASK (DA_WHEEL_L0_SLOTS - 1)
+
+#if defined(HOST_BUILD)
+// no Timer2 on the host, millis() is the tick
+#else
+#include <util/atomic.h>
+
+static volatile uint32_t wheelTicks = 0;
+
+ISR(TIMER2_COMPA_vect) { wheelTicks++; }
+#endif
+
+DA_TimerWheel::DA_TimerWheel() {
+  memset(level0, 0, sizeof(level0));
+  memset(level1, 0, sizeof(level1));
+}
+
+void DA_TimerWheel::init() {
+#if !defined(HOST_BUILD)
+  // CTC on OCR2A, clk/128: 16 MHz / 128 / 125 = 1 kHz. The OC2A/OC2B pins
+  // stay disconnected, Timer0 (millis) and Timer1 (AO PWM) are untouched
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    TCCR2A = _BV(WGM21);
+    TCCR2B = _BV(CS22) | _BV(CS20);
+    OCR2A = F_CPU / 128 / (1000 / DA_WHEEL_TICK_MS) - 1;
+    TCNT2 = 0;
+    TIFR2 = _BV(OCF2A);
+    TIMSK2 = _BV(OCIE2A);
+  }
+#endif
+  wheelTick = now();
+}
+
+uint32_t DA_TimerWheel::now() {
+#if defined(HOST_BUILD)
+  return millis() / DA_WHEEL_TICK_MS;
+#else
+  uint32_t ticks;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) { ticks = wheelTicks; }
+  return ticks;
+#endif
+}
+
+void DA_TimerWheel::insert(DA_WheelTimer &aTimer) {
+  DA_WheelTimer **head;
+  int32_t delta = aTimer.expires - wheelTick;
+  uint32_t blocks =
+      (aTimer.expires >> DA_WHEEL_L0_BITS) - (wheelTick >> DA_WHEEL_L0_BITS);
+
+  if (delta <= 0) // overdue, fire on the next tick
+    head = &level0[(wheelTick + 1) & L0_MASK];
+  else if (blocks == 0)
+    head = &level0[aTimer.expires & L0_MASK];
+  else if (blocks <= DA_WHEEL_L1_SLOTS)
+    head = &level1[(aTimer.expires >> DA_WHEEL_L0_BITS) % DA_WHEEL_L1_SLOTS];
+  else // beyond the wheel, re-filed when this slot next cascades
+    head = &level1[(wheelTick >> DA_WHEEL_L0_BITS) % DA_WHEEL_L1_SLOTS];
+
+  aTimer.next = *head;
+  if (aTimer.next != NULL)
+    aTimer.next->pprev = &aTimer.next;
+  *head = &aTimer;
+  aTimer.pprev = head;
+}
+
+void DA_TimerWheel::start(DA_WheelTimer &aTimer, uint32_t aDelay,
+                          uint32_t aPeriod, DA_WheelCallback aCallback,
+                          void *aContext) {
+  stop(aTimer);
+  aTimer.expires = now() + aDelay / DA_WHEEL_TICK_MS;
+  aTimer.period = aPeriod / DA_WHEEL_TICK_MS;
+  aTimer.callback = aCallback;
+  aTimer.context = aContext;
+  insert(aTimer);
+}
+
+void DA_TimerWheel::stop(DA_WheelTimer &aTimer) {
+  if (aTimer.pprev == NULL)
+    return;
+
+  *aTimer.pprev = aTimer.next;
+  if (aTimer.next != NULL)
+    aTimer.next->pprev = aTimer.pprev;
+  aTimer.next = NULL;
+  aTimer.pprev = NULL;
+}
+
+// move the level 1 slot for the block starting at wheelTick down
+void DA_TimerWheel::cascade() {
+  DA_WheelTimer **slot =
+      &level1[(wheelTick >> DA_WHEEL_L0_BITS) % DA_WHEEL_L1_SLOTS];
+  DA_WheelTimer *timer = *slot;
+
+  *slot = NULL;
+  while (timer != NULL) {
+    DA_WheelTimer *next = timer->next;
+
+    insert(*timer);
+    timer = next;
+  }
+}
+
+void DA_TimerWheel::service() {
+  uint32_t target = now();
+  uint32_t backlog = target - wheelTick;
+
+  if (backlog > maxBacklog)
+    maxBacklog = backlog > 0xFFFF ? 0xFFFF : backlog;
+
+  while (wheelTick != target) {
+    wheelTick++;
+    if ((wheelTick & L0_MASK) == 0)
+      cascade();
+
+    // detach the slot so callbacks can re-arm or stop any timer safely
+    DA_WheelTimer **slot = &level0[wheelTick & L0_MASK];
+    pending = *slot;
+    if (pending != NULL)
+      pending->pprev = &pending;
+    *slot = NULL;
+
+    while (pending != NULL) {
+      DA_WheelTimer *timer = pending;
+
+      stop(*timer);
+      if ((int32_t)(timer->expires - wheelTick) > 0) {
+        insert(*timer); // not ours yet
+        continue;
+      }
+
+      if (timer->period) {
+        // fixed rate, but skip periods that were missed entirely
+        timer->expires += timer->period;
+        if ((int32_t)(timer->expires - wheelTick) <= 0)
+          timer->expires = wheelTick + timer->period;
+        insert(*timer);
+      }
+      timer->callback(timer->context);
+    }
+  }
+}
@@ -0,0 +1,72 @@
+/**
+ *  @file    DA_TimerWheel.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Hierarchical timer wheel for periodic and one shot work.
+ *
+ *  Timer2 interrupts every 1 ms and only counts ticks. service(), called
+ *  from loop(), walks the ticks since the last call and fires the timers
+ *  in the level 0 slot of each tick, so callbacks run in loop() context.
+ *  Level 0 has 64 x 1 ms slots, level 1 64 x 64 ms slots that cascade
+ *  into level 0 every 64 ticks. Timers more than ~4 s out are parked in
+ *  level 1 and re-filed each time their slot cascades. 128 list heads in
+ *  all, 256 bytes of RAM.
+ *
+ *  Timers are caller owned (usually static) and linked intrusively, so
+ *  starting, stopping and firing never allocate and are O(1). Periodic
+ *  timers re-arm at a fixed rate from their previous expiry.
+ */
+
+#ifndef DA_TIMERWHEEL_H
+#define DA_TIMERWHEEL_H
+#include <Arduino.h>
+
+#define DA_WHEEL_L0_BITS 6
+#define DA_WHEEL_L0_SLOTS (1 << DA_WHEEL_L0_BITS) // 1 tick each
+#define DA_WHEEL_L1_SLOTS 64                      // L0_SLOTS ticks each
+#define DA_WHEEL_TICK_MS 1
+
+typedef void (*DA_WheelCallback)(void *aContext);
+
+struct _DA_WheelTimer {
+  _DA_WheelTimer *next;
+  _DA_WheelTimer **pprev; // link that points at this timer, NULL if idle
+  uint32_t expires;       // tick
+  uint32_t period;        // ticks, 0 for one shot
+  DA_WheelCallback callback;
+  void *context;
+};
+
+typedef _DA_WheelTimer DA_WheelTimer;
+
+class DA_TimerWheel {
+public:
+  DA_TimerWheel();
+  void init(); // start the Timer2 tick
+
+  void start(DA_WheelTimer &aTimer, uint32_t aDelay, uint32_t aPeriod,
+             DA_WheelCallback aCallback, void *aContext = NULL);
+  void stop(DA_WheelTimer &aTimer);
+  inline bool isActive(DA_WheelTimer &aTimer) { return aTimer.pprev != NULL; }
+
+  void service(); // fire everything due, call from loop()
+  uint32_t now(); // current tick
+
+  inline uint16_t getMaxBacklog() { return maxBacklog; }
+
+private:
+  void insert(DA_WheelTimer &aTimer);
+  void cascade();
+
+  DA_WheelTimer *level0[DA_WHEEL_L0_SLOTS];
+  DA_WheelTimer *level1[DA_WHEEL_L1_SLOTS];
+  DA_WheelTimer *pending = NULL; // timers of the slot being fired
+  uint32_t wheelTick = 0;         // last tick serviced
+  uint16_t maxBacklog = 0;        // most ticks caught up in one service()
+};
+
+#endif // DA_TIMERWHEEL_H
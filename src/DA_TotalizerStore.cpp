@@ -0,0 +1,47 @@
+/**
+ *  @file    DA_TotalizerStore.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Rotating EEPROM checkpoints for totalizers, see DA_TotalizerStore.h
+ **/
+
+#include "DA_TotalizerStore.h"
+#include <Streaming.h>
+
+static_assert(sizeof(DA_TotalizerSlot) <= DA_RECORD_RING_MAX_SIZE,
+              "DA_TotalizerSlot too big for DA_RecordRing");
+
+DA_TotalizerStore::DA_TotalizerStore(uint16_t aEEPROMAddress,
+                                     uint8_t aSlotCount)
+    : ring(aEEPROMAddress, aSlotCount, sizeof(DA_TotalizerSlot),
+           offsetof(DA_TotalizerSlot, crc)) {}
+
+bool DA_TotalizerStore::load(uint32_t *aTotals) {
+  DA_TotalizerSlot record;
+
+  if (!ring.load(&record))
+    return false;
+  memcpy(aTotals, record.totals, sizeof(record.totals));
+  return true;
+}
+
+void DA_TotalizerStore::save(const uint32_t *aTotals) {
+  DA_TotalizerSlot record;
+
+  memset(&record, 0, sizeof(record)); // host padding
+  memcpy(record.totals, aTotals, sizeof(record.totals));
+  ring.append(&record);
+}
+
+void DA_TotalizerStore::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{totalizer ");
+  ring.serialize(aOutputStream);
+  *aOutputStream << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
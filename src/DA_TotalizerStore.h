@@ -0,0 +1,56 @@
+/**
+ *  @file    DA_TotalizerStore.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  32 bit totalizers checkpointed to a ring of EEPROM slots.
+ *
+ *  Checkpoints go round a DA_RecordRing: save() stages, service() writes a
+ *  byte per loop() pass, so the ~36 ms of a slot write never blocks
+ *  loop(), and a checkpoint torn by a power loss only costs that
+ *  checkpoint.
+ *
+ *  Cell life: with a checkpoint every 15 min and 16 slots each slot is
+ *  written 10 years * 35040 / 16 = ~22000 times, well under the 100000
+ *  cycles of the ATmega2560 EEPROM.
+ */
+
+#ifndef DA_TOTALIZERSTORE_H
+#define DA_TOTALIZERSTORE_H
+#include "DA_RecordRing.h"
+#include <Arduino.h>
+
+#define DA_TOTALIZER_COUNT 2
+
+typedef struct {
+  uint16_t sequence;
+  uint32_t totals[DA_TOTALIZER_COUNT];
+  uint8_t crc; // CRC-8 (Dallas/Maxim) of the bytes above
+} DA_TotalizerSlot;
+
+class DA_TotalizerStore {
+public:
+  DA_TotalizerStore(uint16_t aEEPROMAddress, uint8_t aSlotCount);
+  // newest valid checkpoint, false if none or one is still being written
+  bool load(uint32_t *aTotals);
+  void save(const uint32_t *aTotals);
+  inline void service() { ring.service(); } // call every loop() pass
+  inline void flush() { ring.flush(); }     // blocking, before a reboot
+
+  inline bool isBusy() { return ring.isBusy(); }
+  inline uint16_t getSequence() { return ring.getSequence(); }
+  inline uint16_t getSaves() { return ring.getAppends(); } // since boot
+  inline static uint16_t getSize(uint8_t aSlotCount) {
+    return aSlotCount * sizeof(DA_TotalizerSlot);
+  }
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  DA_RecordRing ring;
+};
+
+#endif // DA_TOTALIZERSTORE_H
@@ -0,0 +1,58 @@
+/**
+ *  @file    DA_Trace.cpp
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Binary event trace framing, see DA_Trace.h
+ **/
+
+#include "DA_Trace.h"
+#include "DA_CRC8.h"
+#include <Streaming.h>
+
+uint8_t DA_Trace::getPending() {
+  return (head - tail) & (DA_TRACE_RECORDS - 1);
+}
+
+uint8_t DA_Trace::drain(Print &aOutput, int aRoom) {
+  uint8_t frames = 0;
+
+  while (aRoom >= DA_TRACE_FRAME_SIZE && tail != head) {
+    const DA_TraceRecord &entry = ring[tail];
+    uint8_t frame[DA_TRACE_FRAME_SIZE] = {
+        DA_TRACE_SYNC_0,
+        DA_TRACE_SYNC_1,
+        entry.id,
+        entry.sequence,
+        (uint8_t)entry.arg0,
+        (uint8_t)(entry.arg0 >> 8),
+        (uint8_t)entry.arg1,
+        (uint8_t)(entry.arg1 >> 8),
+        (uint8_t)entry.micros,
+        (uint8_t)(entry.micros >> 8),
+        (uint8_t)(entry.micros >> 16),
+        (uint8_t)(entry.micros >> 24),
+        0};
+
+    // the slot is only handed back to record() once it has been copied
+    tail = (tail + 1) & (DA_TRACE_RECORDS - 1);
+    frame[DA_TRACE_FRAME_SIZE - 1] = daCRC8(frame + 2, DA_TRACE_FRAME_SIZE - 3);
+    aOutput.write(frame, DA_TRACE_FRAME_SIZE);
+    aRoom -= DA_TRACE_FRAME_SIZE;
+    frames++;
+    sent++;
+  }
+  return frames;
+}
+
+void DA_Trace::serialize(Stream *aOutputStream, bool includeCR) {
+  *aOutputStream << F("{trace enabled:") << isEnabled << F(" pending:")
+                 << getPending() << F("/") << DA_TRACE_RECORDS << F(" sent:")
+                 << sent << F(" lost:") << lost << F(" }");
+
+  if (includeCR)
+    *aOutputStream << endl;
+}
@@ -0,0 +1,99 @@
+/**
+ *  @file    DA_Trace.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Binary event trace, fixed size records in a RAM ring.
+ *
+ *  record() stores an event id, two 16 bit arguments and micros() with
+ *  interrupts held off for a handful of stores, no formatting, so it is
+ *  cheap enough for control loops and ISRs. When the ring is full the
+ *  record is lost, the per record sequence number shows the gap.
+ *
+ *  drain() sends whole frames, as many as the given room allows:
+ *    0xA5 0x5A id seq arg0(LE) arg1(LE) micros(LE, 4) crc8
+ *  13 bytes, CRC-8 over id..micros. The sync and CRC let frames share the
+ *  debug serial port with text, tools/tracedecode picks them out and
+ *  prints them with the text from DA_TraceEvents.h.
+ */
+
+#ifndef DA_TRACE_H
+#define DA_TRACE_H
+#include <Arduino.h>
+
+#define DA_TRACE_RECORDS 32 // power of 2, 10 bytes each
+#define DA_TRACE_SYNC_0 0xA5
+#define DA_TRACE_SYNC_1 0x5A
+#define DA_TRACE_FRAME_SIZE 13
+
+enum DA_TraceId {
+#define DA_TRACE_EVENT(aId, aFormat) aId,
+#include "DA_TraceEvents.h"
+#undef DA_TRACE_EVENT
+  TR_EVENT_COUNT
+};
+
+#define DA_TRACE(aTrace, aId, aArg0, aArg1)                                    \
+  (aTrace).record(aId, (uint16_t)(aArg0), (uint16_t)(aArg1))
+
+typedef struct {
+  uint32_t micros;
+  uint16_t arg0;
+  uint16_t arg1;
+  uint8_t id;
+  uint8_t sequence; // wraps, gaps are lost records
+} DA_TraceRecord;
+
+class DA_Trace {
+public:
+  inline void record(uint8_t aId, uint16_t aArg0, uint16_t aArg1) {
+    if (!isEnabled)
+      return;
+
+    uint32_t now = micros();
+#if !defined(HOST_BUILD)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    uint8_t next = (head + 1) & (DA_TRACE_RECORDS - 1);
+
+    if (next != tail) {
+      DA_TraceRecord &entry = ring[head];
+
+      entry.micros = now;
+      entry.arg0 = aArg0;
+      entry.arg1 = aArg1;
+      entry.id = aId;
+      entry.sequence = sequence;
+      head = next;
+    } else
+      lost++;
+    sequence++;
+#if !defined(HOST_BUILD)
+    SREG = oldSREG;
+#endif
+  }
+
+  // whole frames that fit in aRoom bytes, returns the frames sent
+  uint8_t drain(Print &aOutput, int aRoom);
+
+  inline void setEnabled(bool aEnabled) { isEnabled = aEnabled; }
+  inline bool getEnabled() { return isEnabled; }
+  uint8_t getPending();
+
+  void serialize(Stream *aOutputStream, bool includeCR);
+
+private:
+  DA_TraceRecord ring[DA_TRACE_RECORDS];
+  volatile uint8_t head = 0; // next record
+  volatile uint8_t tail = 0; // next drained
+  uint8_t sequence = 0;
+  uint16_t lost = 0;
+  uint16_t sent = 0;
+  bool isEnabled = true;
+};
+
+#endif // DA_TRACE_H
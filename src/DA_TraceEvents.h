@@ -0,0 +1,29 @@
+/**
+ *  @file    DA_TraceEvents.h
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Trace event table, the one place event ids are defined. Included by
+ *  DA_Trace.h for the firmware ids and by tools/tracedecode for the text,
+ *  each with its own DA_TRACE_EVENT(). Append only, the decoder of an
+ *  older build would mislabel renumbered events.
+ *
+ *  The format gets the two 16 bit arguments, %d prints them signed,
+ *  %u/%x unsigned.
+ */
+
+// no include guard, included once per DA_TRACE_EVENT definition
+
+DA_TRACE_EVENT(TR_BOOT, "boot version:%x device:%u")
+DA_TRACE_EVENT(TR_HOST_SYNCED, "host synced writes:%u timeout:%u")
+DA_TRACE_EVENT(TR_LIGHT_STATE, "light motion state:%u position:%u")
+DA_TRACE_EVENT(TR_LIGHT_SETTLED, "light settled position:%u target:%u")
+DA_TRACE_EVENT(TR_LIGHT_FAULT, "light encoder fault status:%x velocity:%d")
+DA_TRACE_EVENT(TR_LIGHT_HOMING, "light homing status:%x position:%u")
+DA_TRACE_EVENT(TR_JOURNAL_APPEND, "journal append sequence:%u position:%u")
+DA_TRACE_EVENT(TR_FLOW_SAMPLE, "flow sample XT_006:%u XT_007:%u pulses")
+DA_TRACE_EVENT(TR_TOTALIZER_SAVE, "totalizer save sequence:%u saves:%u")
+DA_TRACE_EVENT(TR_REBOOT, "reboot requested writes:%u heartbeat:%u")
@@ -18,6 +18,9 @@
 #include <Ethernet.h>
 #include <MgsModbus.h> // cchange memory size here
 #include <avr/wdt.h>
+#if !defined(HOST_BUILD)
+#include <avr/eeprom.h>
+#endif
 
 
 #include <Encoder.h>
@@ -27,18 +30,28 @@
 
 
 #include <DA_AnalogOutput.h>
-#include <DA_Analoginput.h>
 #include <DA_AtlasMgr.h>
-#include <DA_DiscreteOutput.h>
 #include <DA_DiscreteOutputTmr.h>
-#include <DA_Discreteinput.h>
-#include <DA_Flowmeter.h>
-#include <DA_NonBlockingDelay.h>
-#include <DA_OneWireDallasMgr.h>
 
 #include "Controllino.h"
+#include "DA_ADCSampler.h"
+#include "DA_Bench.h"
+#include "DA_DiscreteInputScanner.h"
+#include "DA_DiscreteOutputBank.h"
+#include "DA_EncoderMonitor.h"
+#include "DA_FlowCounter.h"
+#include "DA_HomingSequence.h"
+#include "DA_Logger.h"
+#include "DA_MotionController.h"
+#include "DA_OneWireTemperatureMgr.h"
+#include "DA_PositionJournal.h"
+#include "DA_TimerFlowCounter.h"
+#include "DA_TotalizerStore.h"
 #include "DA_SCD30.h"
 #include "DA_TCPCommandHandler.h"
+#include "DA_TaskScheduler.h"
+#include "DA_TimerWheel.h"
+#include "DA_Trace.h"
 #include "remoteIO.h"
 
 char atlasrxBuff[DA_ATLAS_RX_BUF_SZ];
@@ -57,9 +70,22 @@ DA_SCD30 SCD30Sensor = DA_SCD30(Serial2);
 // Encoder lightPosition(CONTROLLINO_IN0, CONTROLLINO_IN1);
 Encoder lightPosition(CONTROLLINO_IN1, CONTROLLINO_IN0);
 LightPositionControlData lightPositionControlData;
+DA_MotionController lightMotion(LIGHT_MOTION_PERIOD);
+DA_EncoderMonitor lightEncoder(LIGHT_MOTION_PERIOD);
+DA_PositionJournal lightJournal(EEPROM_LIGHT_JOURNAL_ADDR,
+                                EEPROM_LIGHT_JOURNAL_SLOTS);
+DA_HomingSequence lightHoming(LIGHT_MOTION_PERIOD);
+#else
+#if defined(XT006_TIMER_COUNTER)
+DA_TimerFlowCounter XT_006(XT006_TIMER_COUNTER, FLOW_CALC_PERIOD_SECONDS);
 #else
-DA_FlowMeter XT_006(XT006_SENSOR_INTERUPT_PIN, FLOW_CALC_PERIOD_SECONDS);
-DA_FlowMeter XT_007(XT007_SENSOR_INTERUPT_PIN, FLOW_CALC_PERIOD_SECONDS);
+DA_FlowCounter XT_006(XT006_SENSOR_INTERUPT_PIN, FLOW_CALC_PERIOD_SECONDS);
+#endif
+#if defined(XT007_TIMER_COUNTER)
+DA_TimerFlowCounter XT_007(XT007_TIMER_COUNTER, FLOW_CALC_PERIOD_SECONDS);
+#else
+DA_FlowCounter XT_007(XT007_SENSOR_INTERUPT_PIN, FLOW_CALC_PERIOD_SECONDS);
+#endif
 #endif
 
 DA_TCPCommandHandler remoteCommandHandler = DA_TCPCommandHandler();
@@ -97,12 +123,20 @@ byte pendingMAC[] = {DEFAULT_PENDING_MAC_ADDRESS};
 #if not defined(GC_BUILD)
 void onXT_006_PulseIn();
 void onXT_007_PulseIn();
-void onFlowCalc();
+void onFlowCalc(void *aContext);
+void onTotalizerCheckpoint(void *aContext);
+void doCheckTotalizerResets();
 #else
 void doLightPositionControl();
+void onLightMotionStep(void *aContext);
+void configureLightMotion();
+void journalLightPosition();
+void traceLightChanges();
 void onHomeLimitSwitchRisingEdge(bool state,
                           int aPin);
 bool isLightPositionWriteRequest();
+bool isLightFaultResetRequest();
+bool isLightHomingRequest();
 #endif
 
 void processHostWrites();
@@ -110,20 +144,31 @@ void refreshHostReads();
 void refreshModbusRegisters();
 void refreshAnalogs();
 void refreshDiscreteInputs();
-
+void addSchedulerTasks();
 void onRestoreDefaults(bool aValue, int aPin);
-void onHeartBeat();
+void onHeartBeat(void *aContext);
 void refreshTemperatureUUID(uint16_t aModbusAddressLow,
                             uint16_t aModbusAddressHigh, uint64_t aUUID);
+void refreshTemperatureBlock();
 
 void doIPMACChange();
 void doCheckIPMACChange();
 bool detectTransition(bool aDirection, bool aState, bool aPreviousState);
+uint8_t detectTransition(bool aCurrentState, bool aPreviousState);
 void doCheckRestoreDefaults();
 void doCheckForRescanOneWire();
 void EEPROMWriteCurrentIPs();
 void EEPROMLoadConfig();
+void EEPROMLoadLightPosition();
 void EEPROMWriteDefaultConfig();
+void EEPromWriteOneWireMaps();
+void EEPROMServiceOneWireMaps();
+void EEPROMFlushOneWireMaps();
+void EEPROMLoadHostWrites();
+void EEPROMWriteHostWrites(void *aContext);
+void EEPROMServiceHostWrites();
+void doCheckHostWrites();
+void onHostSyncTimeout(void *aContext);
 void doCheckMACChange();
 void doCheckRebootDevice();
 void rebootDevice();
@@ -147,89 +192,63 @@ uint32_t byteSwap32(uint32_t aValue);
 uint16_t byteSwap16(uint16_t aValue);
 
 // Discrete Inputs
-///
-
-DA_DiscreteInput DI_000 =
-    DA_DiscreteInput(CONTROLLINO_DI0, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_001 =
-    DA_DiscreteInput(CONTROLLINO_DI1, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_002 =
-    DA_DiscreteInput(CONTROLLINO_DI2, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_003 =
-    DA_DiscreteInput(CONTROLLINO_DI3, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_004 = DA_DiscreteInput(
-    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_08, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_005 = DA_DiscreteInput(
-    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_09, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_006 = DA_DiscreteInput(
-    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_10, DA_DiscreteInput::None, false);
-#if not defined(GC_BUILD)
-DA_DiscreteInput DI_007 = DA_DiscreteInput(
-    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_11, DA_DiscreteInput::None, false);
-#else
-DA_DiscreteInput DI_007 =
-    DA_DiscreteInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_11,
-                     DA_DiscreteInput::RisingEdgeDetect, false);
-#endif
-DA_DiscreteInput DI_008 =
-    DA_DiscreteInput(CONTROLLINO_A12, DA_DiscreteInput::None, false);
-DA_DiscreteInput DI_009 =
-    DA_DiscreteInput(CONTROLLINO_A13, DA_DiscreteInput::None, false);
-
-// reset IP to defaults
-DA_DiscreteInput CI_001 =
-    DA_DiscreteInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_07,
-                     DA_DiscreteInput::FallingEdgeDetect, false);
+// scanned together, channel n = entry n. DI_000..DI_009 are published as
+// CS_DI_000..CS_DI_009, the last channel is CI_001 (reset IP to defaults)
+const uint8_t discreteInputPins[] = {
+    CONTROLLINO_DI0,
+    CONTROLLINO_DI1,
+    CONTROLLINO_DI2,
+    CONTROLLINO_DI3,
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_08,
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_09,
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_10,
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_11,
+    CONTROLLINO_A12,
+    CONTROLLINO_A13,
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_07};
+
+DA_DiscreteInputScanner discreteInputs;
 
 // Relay Outputs
 //
-DA_DiscreteOutput DY_000 = DA_DiscreteOutput(CONTROLLINO_RELAY_00, HIGH);
-DA_DiscreteOutput DY_001 = DA_DiscreteOutput(CONTROLLINO_RELAY_01, HIGH);
-DA_DiscreteOutput DY_002 = DA_DiscreteOutput(CONTROLLINO_RELAY_02, HIGH);
-DA_DiscreteOutput DY_003 = DA_DiscreteOutput(CONTROLLINO_RELAY_03, HIGH);
-DA_DiscreteOutput DY_004 = DA_DiscreteOutput(CONTROLLINO_RELAY_04, HIGH);
-DA_DiscreteOutput DY_005 = DA_DiscreteOutput(CONTROLLINO_RELAY_05, HIGH);
-DA_DiscreteOutput DY_006 = DA_DiscreteOutput(CONTROLLINO_RELAY_06, HIGH);
-DA_DiscreteOutput DY_007 = DA_DiscreteOutput(CONTROLLINO_RELAY_07, HIGH);
-DA_DiscreteOutput DY_008 = DA_DiscreteOutput(CONTROLLINO_RELAY_08, HIGH);
-DA_DiscreteOutput DY_009 = DA_DiscreteOutput(CONTROLLINO_RELAY_09, HIGH);
-DA_DiscreteOutput DY_010 = DA_DiscreteOutput(CONTROLLINO_DO0, HIGH);
-DA_DiscreteOutput DY_011 = DA_DiscreteOutput(CONTROLLINO_DO1, HIGH);
-DA_DiscreteOutput DY_012 = DA_DiscreteOutput(CONTROLLINO_DO2, HIGH);
-DA_DiscreteOutput DY_013 = DA_DiscreteOutput(CONTROLLINO_DO3, HIGH);
-DA_DiscreteOutput DY_014 = DA_DiscreteOutput(CONTROLLINO_DO4, HIGH);
-DA_DiscreteOutput DY_015 = DA_DiscreteOutput(CONTROLLINO_DO5, HIGH);
-DA_DiscreteOutput DY_016 = DA_DiscreteOutput(CONTROLLINO_DO6, HIGH);
-DA_DiscreteOutput DY_017 = DA_DiscreteOutput(CONTROLLINO_DO7, HIGH);
-DA_DiscreteOutput DY_021 =
-    DA_DiscreteOutput(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_15, HIGH);
-
+// channel n = DY_0nn = coil CW_DY_0nn, resolved to port/bit at compile time
+constexpr DA_DOChannel discreteOutputChannels[] = {
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_00),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_01),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_02),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_03),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_04),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_05),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_06),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_07),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_08),
+    DA_DO_CHANNEL(CONTROLLINO_RELAY_09),
+    DA_DO_CHANNEL(CONTROLLINO_DO0),
+    DA_DO_CHANNEL(CONTROLLINO_DO1),
+    DA_DO_CHANNEL(CONTROLLINO_DO2),
+    DA_DO_CHANNEL(CONTROLLINO_DO3),
+    DA_DO_CHANNEL(CONTROLLINO_DO4),
+    DA_DO_CHANNEL(CONTROLLINO_DO5),
+    DA_DO_CHANNEL(CONTROLLINO_DO6),
+    DA_DO_CHANNEL(CONTROLLINO_DO7),
 #if not defined(NC_BUILD)
-DA_DiscreteOutput DY_018 =
-    DA_DiscreteOutput(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_14, HIGH);
-
-DA_DiscreteOutput DY_019 =
-    DA_DiscreteOutput(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_13, HIGH);
-DA_DiscreteOutput DY_020 =
-    DA_DiscreteOutput(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_12, HIGH);
-
+    DA_DO_CHANNEL(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_14),
+    DA_DO_CHANNEL(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_13),
+    DA_DO_CHANNEL(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_12),
+#else
+    DA_DO_UNUSED,
+    DA_DO_UNUSED,
+    DA_DO_UNUSED,
 #endif // if not defined(NC_BUILD)
+    DA_DO_CHANNEL(CONTROLLINO_PIN_HEADER_DIGITAL_OUT_15)};
+
+DA_DiscreteOutputBank discreteOutputs(discreteOutputChannels,
+                                      sizeof(discreteOutputChannels) /
+                                          sizeof(DA_DOChannel));
 
-// 0-24V
-DA_AnalogInput AI_000 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_00, 0.0, 1024.0);
-DA_AnalogInput AI_001 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_01, 0.0, 1024.0);
-DA_AnalogInput AI_002 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_02, 0.0, 1024.0);
-DA_AnalogInput AI_003 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_03, 0.0, 1024.0);
-DA_AnalogInput AI_004 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_04, 0.0, 1024.0);
-DA_AnalogInput AI_005 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_05, 0.0, 1024.0);
-DA_AnalogInput AI_006 =
-    DA_AnalogInput(CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_06, 0.0, 1024.0);
+// 0-24V AI_000..AI_006 on ADC0..ADC6, sampled round robin by interrupt
+DA_ADCSampler analogSampler = DA_ADCSampler(
+    CONTROLLINO_SCREW_TERMINAL_ANALOG_ADC_IN_00, ANALOG_INPUT_COUNT);
 
 // 0-10 V analog outputs
 DA_AnalogOutput AY_000 = DA_AnalogOutput(CONTROLLINO_AO0);
@@ -239,36 +258,79 @@ DA_AnalogOutput AY_001 = DA_AnalogOutput(CONTROLLINO_AO1);
 uint16_t KI_003 = APP_MAJOR << 8 | APP_MINOR << 4 | APP_PATCH;
 uint16_t KI_005 = DEVICE_TYPE;
 
+// all periodic work runs off the Timer2 driven wheel, see addSchedulerTasks()
+DA_TimerWheel timerWheel = DA_TimerWheel();
+DA_TaskScheduler scheduler = DA_TaskScheduler(timerWheel);
+
 // timer for heart beat and potentially trigger for other operations
-DA_NonBlockingDelay KI_001 =
-    DA_NonBlockingDelay(HEART_BEAT_PERIOD, onHeartBeat);
+DA_WheelTimer KI_001;
 uint16_t KI_001_CV = 0;
 
 // timer for flow calcs
 #if not defined(GC_BUILD)
-DA_NonBlockingDelay KI_004 =
-    DA_NonBlockingDelay(FLOW_CALC_PERIOD_SECONDS * 1000, onFlowCalc);
+DA_WheelTimer KI_004;
+
+// flow totalizers in pulses, checkpointed by KI_008, reset saves by KI_009
+uint32_t flowTotals[DA_TOTALIZER_COUNT];
+uint32_t checkpointTotals[DA_TOTALIZER_COUNT];
+DA_TotalizerStore totalizerStore(EEPROM_TOTALIZER_ADDR,
+                                 EEPROM_TOTALIZER_SLOTS);
+DA_WheelTimer KI_008;
+DA_WheelTimer KI_009;
+#else
+// light position control at a fixed rate, independent of loop() jitter
+DA_WheelTimer KI_010;
 #endif
 
-DA_OneWireDallasMgr temperatureMgr = DA_OneWireDallasMgr(WIRE_BUS_PIN);
+// fast boot: outputs and setpoints come back from EEPROM, light control
+// holds until the host writes or KI_006 expires. KI_007 saves host writes
+DA_WheelTimer KI_006;
+DA_WheelTimer KI_007;
+HostWritesImage hostWritesImage; // being written by the eeprom task
+uint8_t hostWritesIndex = sizeof(HostWritesImage); // next byte, idle at end
+bool isHostSynced = false;
+uint16_t lastHostWriteCount = 0;
+
+// 1-Wire buses, bus n = entry n
+const uint8_t oneWireBusPins[] = ONE_WIRE_BUS_PINS;
+DA_OneWireTemperatureMgr temperatureMgr;
+// next byte of the slot ROMs to write, idle at the end
+uint16_t oneWireMapsIndex = sizeof(temperatureMgr.oneWireSlotROMs);
+#if HR_TI_BLOCK + HR_TI_BLOCK_SIZE > MbDataLen
+#error HR_TI_BLOCK runs past MbData, raise MbDataLen in MgsModbus.h
+#endif
 
-// Debug Serial port
+// Debug Serial port, blocking during setup(), then through the log ring
+DA_Logger logger(Serial);
 Stream *aOutputStream = &Serial;
 
+// binary event trace, on Serial between log lines when isTraceSerial or
+// pulled with remote x. Decode with tools/tracedecode
+DA_Trace trace;
+bool isTraceSerial = DEFAULT_TRACE_SERIAL;
+
 // commands from host that need to be onshots
 bool CY_006 = false; // update IP
 bool CY_001 = false; // restore defaults
 bool CY_002 = false; // rescan one wire temperatures devices
 bool CY_004 = false; // reboot remote I/O
+bool XT_006_RS = false; // reset flow totalizer XT_006
+bool XT_007_RS = false; // reset flow totalizer XT_007
 
 #if defined(IO_DEBUG)
 void onTemperatureRead() {
-  *aOutputStream << "New Sample" << endl;
-
   for (int i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
-    // temperatureMgr.enableSensor(i);
-    *aOutputStream << "idx:" << i << "temp:" << temperatureMgr.getTemperature(i)
-                   << endl;
+    uint16_t lQuality = temperatureMgr.getQuality(i);
+
+    if (lQuality == DA_ONE_WIRE_NO_DATA)
+      continue;
+    // a bad probe fails every cycle, one line per interval for all slots
+    if ((lQuality & 0xFF) == DA_ONE_WIRE_CRC_ERROR ||
+        (lQuality & 0xFF) == DA_ONE_WIRE_MISSING)
+      DA_LOG_EVERY(logger, LOG_REPEAT_INTERVAL, DA_LOG_WARN,
+                   "1-Wire idx:%d quality:%x", i, lQuality);
+    DA_LOG(logger, DA_LOG_DEBUG, "idx:%d temp*10:%d", i,
+           temperatureMgr.getTemperatureX10(i));
   }
 }
 
@@ -277,30 +339,16 @@ void onTemperatureRead() {
 void setup() {
   MCUSR = 0; // clear existing watchdog timer presets
 
-  temperatureMgr.setPollingInterval(DEFAULT_1WIRE_POLLING_INTERVAL);
-  temperatureMgr.setBlockingRead(false);
-  temperatureMgr.scanSensors();
-
 #if defined(IO_DEBUG)
   Serial.begin(19200);
-
-  temperatureMgr.serialize(aOutputStream, true);
-
 #endif // ifdef PROCESS_TERMINAL
 
-  temperatureMgr.init();
-  temperatureMgr.enableMgr();
-#if defined(IO_DEBUG)
-  temperatureMgr.setOnPollCallBack(onTemperatureRead);
-#endif // ifdef IO_DEBUG
-
 // GC has CO2/Humity/Temoerature Sensor
 #if defined(GC_BUILD)
   Serial2.begin(SCD30_BAUD);
 
   SCD30Sensor.init();
   SCD30Sensor.setPollingInterval(DEFAULT_SC30_POLLING_INTERVAL);
-  DI_007.setOnEdgeEvent(&onHomeLimitSwitchRisingEdge);
 
 #endif
 
@@ -314,13 +362,43 @@ void setup() {
   atlasSensorMgr.setPollingInterval(DEFAULT_ATLAS_POLLING_INTERVAL); // ms
   atlasSensorMgr.setEnabled(true);
 
+#endif // if defined(NC_BUILD)
+
+#if not defined(GC_BUILD)
+  // totals continue from the newest checkpoint
+  if (!totalizerStore.load(flowTotals))
+    memset(flowTotals, 0, sizeof(flowTotals));
+  memcpy(checkpointTotals, flowTotals, sizeof(flowTotals));
+
+  // attached for good, onFlowCalc() only snapshots the counters
+  XT_006.begin();
+  XT_007.begin();
   ENABLE_XT006_SENSOR_INTERRUPTS();
   ENABLE_XT007_SENSOR_INTERRUPTS();
-#endif // if defined(NC_BUILD)
+#endif // if not defined(GC_BUILD)
 
   EEPROMLoadConfig();
+  EEPROMLoadLightPosition();
+  EEPROMLoadHostWrites();
+
+  // after EEPROMLoadConfig(), the slots are looked up by their ROM codes
+  for (uint8_t i = 0; i < sizeof(oneWireBusPins); i++)
+    temperatureMgr.addBus(oneWireBusPins[i]);
+  temperatureMgr.setPollingInterval(DEFAULT_1WIRE_POLLING_INTERVAL);
+  temperatureMgr.setDiscoveryInterval(DEFAULT_1WIRE_DISCOVERY_INTERVAL);
+  temperatureMgr.setOnMapCallBack(EEPromWriteOneWireMaps);
+  temperatureMgr.scanSensors();
+#if defined(IO_DEBUG)
+  temperatureMgr.serialize(aOutputStream, true);
+  temperatureMgr.setOnPollCallBack(onTemperatureRead);
+#endif // ifdef IO_DEBUG
+#if defined(SIMAVR_BENCH)
+  // no W5100 under simavr, Modbus frames come in on a UART instead
+  SIMAVR_BENCH_MODBUS_PORT.begin(SIMAVR_BENCH_MODBUS_BAUD);
+#else
   Ethernet.begin(currentMAC, currentIP, currentGateway, currentSubnet);
   remoteCommandHandler.init();
+#endif
   remoteCommandHandler.addCommandHandler(DA_TCP_COMMAND_GROUP_ATLAS,
                                          remoteAtlasCommandHandler);
   remoteCommandHandler.addCommandHandler(DA_TCP_COMMAND_GROUP_REMOTE,
@@ -329,167 +407,278 @@ void setup() {
                                          remoteHelpCommandHandler);
   remoteCommandHandler.addCommandHandler(DA_TCP_COMMAND_GROUP_ONEWIRE,
                                          remoteOneWireCommandHandler);
-  CI_001.setOnEdgeEvent(&onRestoreDefaults);
-  CI_001.setEnabled(true);
-
-  // DI Debounce times // default is 100ms
-  DI_000.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_001.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_002.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_003.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_004.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_005.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_006.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_007.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_008.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-  DI_009.setDebounceTime(DEFAULT_DI_DEBOUNCE_TIME);
-
-  // Enable/Disable DOs from master values
-  AI_000.setEnabled(true);
-  AI_001.setEnabled(true);
-  AI_002.setEnabled(true);
-  AI_003.setEnabled(true);
-  AI_004.setEnabled(true);
-  AI_005.setEnabled(true);
-  AI_006.setEnabled(true);
-
-  // Enable/Disable DOs from master values
-  // Relays
 
-  DY_000.setEnabled(true);
-  DY_001.setEnabled(true);
-  DY_002.setEnabled(true);
-  DY_003.setEnabled(true);
-  DY_004.setEnabled(true);
-  DY_005.setEnabled(true);
-  DY_006.setEnabled(true);
-  DY_007.setEnabled(true);
-  DY_008.setEnabled(true);
-  DY_009.setEnabled(true);
-  DY_010.setEnabled(true);
-  DY_011.setEnabled(true);
-  DY_012.setEnabled(true);
-  DY_013.setEnabled(true);
-  DY_014.setEnabled(true);
-  DY_015.setEnabled(true);
-  DY_016.setEnabled(true);
-  DY_017.setEnabled(true);
-  DY_021.setEnabled(true);
+  // DIs, debounce time is TASK_DISCRETE_INPUTS_PERIOD * 4 scans
+  for (uint8_t i = 0; i < sizeof(discreteInputPins); i++)
+    discreteInputs.addInput(discreteInputPins[i]);
+  discreteInputs.setOnEdgeEvent(CI_CHANNEL_001,
+                                DA_DiscreteInputScanner::FallingEdgeDetect,
+                                onRestoreDefaults);
+#if defined(GC_BUILD)
+  discreteInputs.setOnEdgeEvent(DI_CHANNEL_007,
+                                DA_DiscreteInputScanner::RisingEdgeDetect,
+                                onHomeLimitSwitchRisingEdge);
+#endif
 
-#if not defined(NC_BUILD)
-  DY_018.setEnabled(true);
-  DY_019.setEnabled(true);
-  DY_020.setEnabled(true);
+  // AIs
+  analogSampler.setSampleDivider(DEFAULT_ADC_SAMPLE_DIVIDER);
+  analogSampler.begin();
 
-#endif // if not defined(NC_BUILD)
+  // DOs, off until processHostWrites() drives the restored coils
+  discreteOutputs.begin();
 
   // DIs
-  DI_000.setEnabled(true);
-  DI_001.setEnabled(true);
-  DI_002.setEnabled(true);
-  DI_003.setEnabled(true);
-  DI_004.setEnabled(true);
-  DI_005.setEnabled(true);
-  DI_006.setEnabled(true);
-  DI_007.setEnabled(true);
-  DI_008.setEnabled(true);
-  DI_009.setEnabled(true);
-
-  // DI_003.serialize(aOutputStream, true);
+  discreteInputs.begin();
+
   // AOs
   AY_000.setEnabled(true);
   AY_001.setEnabled(true);
 
-  // wait for data from TBOX to arrive. What is not stored in EEPROM
-  // defaults to 0. Not much of a concern but SP for positioner is maintained
-  // by TBOX and a 0 SP will cause the light to move at startup which may not
-  // be the desired mode of operation if the actual SP is not 0
-  for (int i = 0; i < 5; i++) {
-    MBSlave.MbsRun();
-    processHostWrites();
-#if defined(IO_DEBUG)
-    *aOutputStream << endl << "Setup (" << 5 - i << ")";
-#endif // ifdef IO_DEBUG
-    delay(1200);
-  }
+  // drive the outputs restored from EEPROM right away. The light position
+  // SP is maintained by TBOX, so light control holds (motor off) until TBOX
+  // writes or HOST_SYNC_TIMEOUT expires, then carries on with the restored SP
+  processHostWrites();
+
+  addSchedulerTasks();
+
+  // from here on debug output must not block loop()
+  logger.setLevel(DEFAULT_LOG_LEVEL);
+  aOutputStream = &logger;
+  DA_TRACE(trace, TR_BOOT, KI_003, KI_005);
 }
 
 void loop() {
-  MBSlave.MbsRun();
+  DA_BENCH_MARK(BENCH_LOOP_START);
+  scheduler.run();
+}
 
-#if defined(GC_BUILD)
-  doLightPositionControl();
+// network servicing, every pass. Host writes are applied right away
+void doNetworkTask() {
+#if defined(SIMAVR_BENCH)
+  MBSlave.MbsRun(SIMAVR_BENCH_MODBUS_PORT);
+#else
+  MBSlave.MbsRun();
+#endif
+  doCheckHostWrites();
+  DA_BENCH_MARK(BENCH_MODBUS);
+  processHostWrites();
+  DA_BENCH_MARK(BENCH_HOST_WRITES);
+}
 
+void doCommandsTask() {
+#if not defined(SIMAVR_BENCH)
+  remoteCommandHandler.refresh();
 #endif
+  DA_BENCH_MARK(BENCH_COMMANDS);
+}
 
+void doHostReadsTask() {
   refreshHostReads();
-  processHostWrites();
+  DA_BENCH_MARK(BENCH_HOST_READS);
+}
 
-  temperatureMgr.refresh();
+void doDiscreteInputsTask() {
+  refreshDiscreteInputs();
+  DA_BENCH_MARK(BENCH_DISCRETE_INPUTS);
+}
 
+void doAnalogsTask() {
   refreshAnalogs();
-  refreshDiscreteInputs();
-  KI_001.refresh();
+  DA_BENCH_MARK(BENCH_ANALOGS);
+}
 
-#if not defined(GC_BUILD)
-  KI_004.refresh();
+// background EEPROM writes, one byte per pass
+void doEEPROMTask() {
+  EEPROMServiceHostWrites();
+  EEPROMServiceOneWireMaps();
+#if defined(GC_BUILD)
+  lightJournal.service();
+#else
+  totalizerStore.service();
+#endif
+}
+
+#if defined(IO_DEBUG)
+void doLogTask() {
+  logger.drain();
+  // frames only take what the log left of the TX buffer
+  if (isTraceSerial)
+    trace.drain(Serial, Serial.availableForWrite());
+}
 #endif
 
+void doOneWireTask() {
+  temperatureMgr.refresh();
+  DA_BENCH_MARK(BENCH_ONE_WIRE);
+}
+
 #if defined(GC_BUILD)
-  SCD30Sensor.refresh();
+void onLightMotionStep(void *aContext) {
+  doLightPositionControl();
+  DA_BENCH_MARK(BENCH_LIGHT_CONTROL);
+}
+
+void doSCD30Task() {
+  SCD30Sensor.poll();
+  DA_BENCH_MARK(BENCH_SCD30);
+}
 #endif
 
 #if defined(NC_BUILD)
+void doAtlasTask() {
   atlasSensorMgr.refresh();
-#endif // if defined(NC_BUILD)
-  remoteCommandHandler.refresh();
-  // AY_000.serialize(aOutputStream, true);
+  DA_BENCH_MARK(BENCH_ATLAS);
 }
+#endif // if defined(NC_BUILD)
+
+/**
+ * [addSchedulerTasks register the loop() work with the scheduler]
+ * periods, priorities and budgets are in remoteIO.h. Heart beat and flow
+ * calcs are plain wheel timers. The library managed sensors (1-wire, Atlas)
+ * keep their own polling intervals, their task only has to run often
+ * enough to catch them.
+ */
+void addSchedulerTasks() {
+  timerWheel.init();
+  scheduler.setPassBudget(TASK_PASS_BUDGET);
+
+  timerWheel.start(KI_001, HEART_BEAT_PERIOD, HEART_BEAT_PERIOD, onHeartBeat);
+  if (!isHostSynced)
+    timerWheel.start(KI_006, HOST_SYNC_TIMEOUT, 0, onHostSyncTimeout);
+#if not defined(GC_BUILD)
+  timerWheel.start(KI_004, FLOW_CALC_PERIOD_SECONDS * 1000UL,
+                   FLOW_CALC_PERIOD_SECONDS * 1000UL, onFlowCalc);
+  timerWheel.start(KI_008, TOTALIZER_CHECKPOINT_PERIOD,
+                   TOTALIZER_CHECKPOINT_PERIOD, onTotalizerCheckpoint);
+#else
+  timerWheel.start(KI_010, LIGHT_MOTION_PERIOD, LIGHT_MOTION_PERIOD,
+                   onLightMotionStep);
+#endif
 
-void refreshAnalogs() {
-  AI_000.refresh();
-  AI_001.refresh();
-  AI_002.refresh();
-  AI_003.refresh();
-  AI_004.refresh();
-  AI_005.refresh();
-  AI_006.refresh();
+  scheduler.addTask(doNetworkTask, TASK_NETWORK_PERIOD, TASK_NETWORK_PRIORITY,
+                    TASK_NETWORK_BUDGET, F("network"));
+  scheduler.addTask(doCommandsTask, TASK_COMMANDS_PERIOD,
+                    TASK_COMMANDS_PRIORITY, TASK_COMMANDS_BUDGET,
+                    F("commands"));
+  scheduler.addTask(doDiscreteInputsTask, TASK_DISCRETE_INPUTS_PERIOD,
+                    TASK_DISCRETE_INPUTS_PRIORITY, TASK_DISCRETE_INPUTS_BUDGET,
+                    F("discreteInputs"));
+  scheduler.addTask(doHostReadsTask, TASK_HOST_READS_PERIOD,
+                    TASK_HOST_READS_PRIORITY, TASK_HOST_READS_BUDGET,
+                    F("hostReads"));
+  scheduler.addTask(doAnalogsTask, TASK_ANALOGS_PERIOD,
+                    TASK_ANALOGS_PRIORITY, TASK_ANALOGS_BUDGET, F("analogs"));
+  scheduler.addTask(doEEPROMTask, TASK_EEPROM_PERIOD, TASK_EEPROM_PRIORITY,
+                    TASK_EEPROM_BUDGET, F("eeprom"));
+  scheduler.addTask(doOneWireTask, TASK_ONE_WIRE_PERIOD,
+                    TASK_ONE_WIRE_PRIORITY, TASK_ONE_WIRE_BUDGET,
+                    F("oneWire"));
+#if defined(GC_BUILD)
+  scheduler.addTask(doSCD30Task, DEFAULT_SC30_POLLING_INTERVAL,
+                    TASK_SERIAL_SENSORS_PRIORITY, TASK_SERIAL_SENSORS_BUDGET,
+                    F("scd30"));
+#endif
+#if defined(NC_BUILD)
+  scheduler.addTask(doAtlasTask, TASK_SERIAL_SENSORS_PERIOD,
+                    TASK_SERIAL_SENSORS_PRIORITY, TASK_SERIAL_SENSORS_BUDGET,
+                    F("atlas"));
+#endif // if defined(NC_BUILD)
+#if defined(IO_DEBUG)
+  scheduler.addTask(doLogTask, TASK_LOG_PERIOD, TASK_LOG_PRIORITY,
+                    TASK_LOG_BUDGET, F("log"));
+#endif
 }
 
+// only moves finished conversions out of the ADC ring, never waits
+void refreshAnalogs() { analogSampler.consume(); }
+
+// one scan of all inputs, the packed word goes straight to CS_DI_000..009
 void refreshDiscreteInputs() {
-  DI_000.refresh();
-  DI_001.refresh();
-  DI_002.refresh();
-  DI_003.refresh();
-  DI_004.refresh();
-  DI_005.refresh();
-  DI_006.refresh();
-  DI_007.refresh();
-  DI_008.refresh();
-  DI_009.refresh();
-
-  CI_001.refresh();
+  discreteInputs.scan();
+
+  word *diWord = &MBSlave.MbData[CS_DI_000 / 16];
+
+  *diWord = (*diWord & ~(DI_CHANNEL_MASK << CS_DI_000 % 16)) |
+            (discreteInputs.getInputs() & DI_CHANNEL_MASK) << CS_DI_000 % 16;
 }
 
 #if not defined(GC_BUILD)
-void onFlowCalc() {
-  DISABLE_XT006_SENSOR_INTERRUPTS();
-  DISABLE_XT007_SENSOR_INTERRUPTS();
+void onFlowCalc(void *aContext) {
+  XT_006.sample();
+  XT_007.sample();
+  flowTotals[0] += XT_006.getCurrentPulses();
+  flowTotals[1] += XT_007.getCurrentPulses();
+  DA_TRACE(trace, TR_FLOW_SAMPLE, XT_006.getCurrentPulses(),
+           XT_007.getCurrentPulses());
+}
 
-  XT_006.end();
-  XT_006.begin();
+/**
+ * [onTotalizerCheckpoint save the flow totals to the next EEPROM slot]
+ * skipped while nothing flowed, see DA_TotalizerStore for the wear budget
+ * @param aContext [ unused, wheel timer callback ]
+ */
+void onTotalizerCheckpoint(void *aContext) {
+  if (!memcmp(checkpointTotals, flowTotals, sizeof(flowTotals)))
+    return;
+
+  totalizerStore.save(flowTotals);
+  memcpy(checkpointTotals, flowTotals, sizeof(flowTotals));
+  DA_TRACE(trace, TR_TOTALIZER_SAVE, totalizerStore.getSequence(),
+           totalizerStore.getSaves());
+}
 
-  XT_007.end();
-  XT_007.begin();
-  ENABLE_XT006_SENSOR_INTERRUPTS();
-  ENABLE_XT007_SENSOR_INTERRUPTS();
+void doCheckTotalizerResets() {
+  bool isReset = false;
+
+  if (detectTransition(MBSlave.GetBit(CW_XT_006_RS), XT_006_RS) ==
+      BIT_RISING_EDGE) {
+    flowTotals[0] = 0;
+    isReset = true;
+  }
+  XT_006_RS = MBSlave.GetBit(CW_XT_006_RS);
+
+  if (detectTransition(MBSlave.GetBit(CW_XT_007_RS), XT_007_RS) ==
+      BIT_RISING_EDGE) {
+    flowTotals[1] = 0;
+    isReset = true;
+  }
+  XT_007_RS = MBSlave.GetBit(CW_XT_007_RS);
+
+  // a reset must survive a reboot, but repeated resets only save once
+  if (isReset)
+    timerWheel.start(KI_009, TOTALIZER_RESET_SAVE_DELAY, 0,
+                     onTotalizerCheckpoint);
 }
 
-void onXT_006_PulseIn() { XT_006.handleFlowDetection(); }
+void onXT_006_PulseIn() { XT_006.handlePulse(); }
 
-void onXT_007_PulseIn() { XT_007.handleFlowDetection(); }
+void onXT_007_PulseIn() { XT_007.handlePulse(); }
 #endif
-void onHeartBeat() { KI_001_CV++; }
+void onHeartBeat(void *aContext) { KI_001_CV++; }
+
+void onHostSyncTimeout(void *aContext) {
+  DA_LOG(logger, DA_LOG_INFO, "host sync timeout, using restored setpoints");
+  DA_TRACE(trace, TR_HOST_SYNCED, MBSlave.MbsWriteCount, 1);
+  isHostSynced = true;
+}
+
+/**
+ * [doCheckHostWrites end the boot hold on the first host write and save
+ *                    host written state once writes settle]
+ */
+void doCheckHostWrites() {
+  if (MBSlave.MbsWriteCount == lastHostWriteCount)
+    return;
+
+  lastHostWriteCount = MBSlave.MbsWriteCount;
+  if (!isHostSynced) {
+    isHostSynced = true;
+    timerWheel.stop(KI_006);
+    DA_TRACE(trace, TR_HOST_SYNCED, lastHostWriteCount, 0);
+  }
+  // restarting defers the save while the host keeps writing
+  timerWheel.start(KI_007, HOST_WRITES_SAVE_DELAY, 0, EEPROMWriteHostWrites);
+}
 
 /**
  * [onRestoreDefaults restore defaults in EEPROM]
@@ -499,12 +688,13 @@ void onHeartBeat() { KI_001_CV++; }
  * @param aPin   [ don't care if invoked directly ]
  */
 void onRestoreDefaults(bool aValue, int aPin) {
-#if defined(IO_DEBUG)
-  *aOutputStream << "onRestoreDefaults()" << endl;
-#endif // ifdef IO_DEBUG
+  DA_LOG(logger, DA_LOG_INFO, "onRestoreDefaults()");
 
   EEPROMWriteDefaultConfig();
   EEPROMLoadConfig();
+#if defined(GC_BUILD)
+  configureLightMotion(); // default travel
+#endif
   Ethernet.begin(currentMAC, currentIP, currentGateway, currentSubnet);
 }
 
@@ -538,6 +728,7 @@ uint32_t byteSwap32(uint32_t aValue) {
   return w1 << 16 | w2;
 }
 
+#if defined(GC_BUILD)
 void computeLightPosition() {
   lightPositionControlData.currentPositionCount = lightPosition.read();
   if (lightPositionControlData.currentPositionCount !=
@@ -550,15 +741,79 @@ void computeLightPosition() {
   }
 }
 
+void journalLightPosition() {
+  lightJournal.append(lightPositionControlData.currentPositionCount,
+                      lightPositionControlData.maxPulses);
+  DA_TRACE(trace, TR_JOURNAL_APPEND, lightJournal.getSequence(),
+           lightPositionControlData.currentPositionCount);
+}
+
+// motion state, encoder fault and homing status transitions, cheap enough
+// for every LIGHT_MOTION_PERIOD
+void traceLightChanges() {
+  if (lightMotion.getState() != lightPositionControlData.tracedState) {
+    lightPositionControlData.tracedState = lightMotion.getState();
+    DA_TRACE(trace, TR_LIGHT_STATE, lightMotion.getState(),
+             lightPositionControlData.currentPositionCount);
+  }
+  // MOVING and MOTOR_ON follow the drive pulses, only faults are traced
+  uint16_t lStatus = lightEncoder.getStatus() & DA_ENCODER_FAULTS;
+  if (lStatus != lightPositionControlData.tracedStatus) {
+    lightPositionControlData.tracedStatus = lStatus;
+    DA_TRACE(trace, TR_LIGHT_FAULT, lStatus, lightEncoder.getVelocity());
+    // a marginal encoder can flap, the trace keeps every transition
+    DA_LOG_EVERY(logger, LOG_REPEAT_INTERVAL, DA_LOG_WARN,
+                 "ZIC_015 encoder faults:%x velocity:%ld", lStatus,
+                 (long)lightEncoder.getVelocity());
+  }
+  if (lightHoming.getStatus() != lightPositionControlData.tracedHoming) {
+    lightPositionControlData.tracedHoming = lightHoming.getStatus();
+    DA_TRACE(trace, TR_LIGHT_HOMING, lightHoming.getStatus(),
+             lightPositionControlData.currentPositionCount);
+    DA_LOG_EVERY(logger, LOG_REPEAT_INTERVAL, DA_LOG_INFO,
+                 "ZIC_015 homing status:%x pos:%ld", lightHoming.getStatus(),
+                 (long)lightPositionControlData.currentPositionCount);
+  }
+}
+
 void onHomeLimitSwitchRisingEdge(bool state, int aPin) {
 
   //  lightPositionControlData.isHomed = true;
-  DY_007.write(false);
+  discreteOutputs.write(DY_CHANNEL_007, false);
+  discreteOutputs.apply();
 }
+/**
+ * [configureLightMotion motion profile in encoder counts]
+ * deadband and slowdown zone scale with the calibrated travel (maxPulses)
+ */
+void configureLightMotion() {
+  uint16_t lZone = MBSlave.MbData[HW_ZIC_015_SZ];
+
+  lightPositionControlData.slowdownZone = lZone;
+  if (lZone == 0 || lZone > 1000)
+    lZone = DEFAULT_LIGHT_SLOWDOWN_ZONE;
+  lightMotion.setDeadband(DEFAULT_LIGHT_POSITION_DEADBAND *
+                          lightPositionControlData.maxPulses / 100.0);
+  lightMotion.setSlowdownZone(lightPositionControlData.maxPulses * lZone /
+                              1000UL);
+  lightMotion.setRampTime(LIGHT_MOTION_RAMP_TIME);
+  lightMotion.setCoastTime(LIGHT_MOTION_COAST_TIME);
+  lightMotion.setReverseDelay(LIGHT_MOTION_REVERSE_DELAY);
+  lightMotion.setPulseWindow(LIGHT_MOTION_PULSE_WINDOW);
+  lightMotion.setMinDrive(LIGHT_MOTION_MIN_DRIVE);
+  lightEncoder.setStallTime(LIGHT_STALL_TIME);
+  lightEncoder.setMismatchCounts(LIGHT_MISMATCH_COUNTS);
+  lightHoming.setEndTime(LIGHT_HOMING_END_TIME);
+  lightHoming.setTimeout(LIGHT_HOMING_TIMEOUT);
+  lightHoming.setMinTravel(LIGHT_HOMING_MIN_TRAVEL);
+  lightHoming.setTolerance(LIGHT_HOMING_TOLERANCE);
+}
+
 /**
  * [doLightPositionControl ]
- *  Control the light position using via a setpoint from the HMI
- *  if the limit switch is met stop the motor
+ *  Control the light position using via a setpoint from the HMI, every
+ *  LIGHT_MOTION_PERIOD from KI_010. lightMotion ramps the drive and stops
+ *  short by the coast distance. if the limit switch is met stop the motor
  * Note: 100% -> lowest  light position e.g. close to plants
  *        0   -> highest light position e.g. away to plants
  *        when arm is completely retracted count = 0
@@ -569,15 +824,13 @@ void onHomeLimitSwitchRisingEdge(bool state, int aPin) {
  */
 void doLightPositionControl() {
 
-  bool lLimitSwitch = DI_007.getSample(); // at the lowest allowed position
-  bool lDirection;
-  float lError;
-  bool lMotorState = false; // default off
+  // at the lowest allowed position
+  bool lLimitSwitch = discreteInputs.getSample(DI_CHANNEL_007);
+  bool lMotorState;
 
   bool ZIC_015_MH = MBSlave.GetBit(CW_ZIC_015_MH);
   bool ZIC_015_MT = MBSlave.GetBit(CW_ZIC_015_MT);
   bool ZIC_015_CL = MBSlave.GetBit(CW_ZIC_015_CL);
-  bool ZIC_015_SV = MBSlave.GetBit(CW_ZIC_015_SV);
 
   computeLightPosition();
 
@@ -585,65 +838,84 @@ void doLightPositionControl() {
   if (lLimitSwitch)
     lightPosition.write(0);
 
-  // Calibration mode
-  if (ZIC_015_CL) {
-    // if a HMI from host to move to home and it is not in home position
-    // don't go home if the go to top command is in progress
-    if (ZIC_015_MH && !ZIC_015_MT) {
-      lDirection = false;
-      lMotorState = !lLimitSwitch;
-    }
-
-    // if a HMI from host to move to top position
-    if (ZIC_015_MT) {
-      // don't go top if the go to home command is in progress
-      if (!ZIC_015_MH) {
-        lDirection = true;
-        lMotorState = true;
-      } else
-        lMotorState = false;
+  if (isLightFaultResetRequest())
+    lightEncoder.reset();
+  if (isLightHomingRequest())
+    lightHoming.start(LIGHT_HOMING_PASSES);
+
+  if (!isHostSynced || lightEncoder.isFaulted()) {
+    // fast boot: hold until the host has synced the SP. A stall or
+    // direction fault holds until CW_ZIC_015_FR
+    lightMotion.stop();
+    lightHoming.abort();
+  } else if (lightHoming.isActive()) {
+    // automatic homing and travel calibration, see DA_HomingSequence
+    lightMotion.jog(lightHoming.step(
+        lightPositionControlData.currentPositionCount, lLimitSwitch,
+        lightMotion.getState() == DA_MotionController::Idle));
+
+    if (lightHoming.isResultReady()) {
+      lightPositionControlData.maxPulses = lightHoming.getResult();
+      journalLightPosition();
+      configureLightMotion();
     }
+  } else if (ZIC_015_CL) {
+    // Calibration mode, HMI jogs home or to the top. don't go home if the
+    // go to top command is in progress and vice versa
+    if (ZIC_015_MH && !ZIC_015_MT && !lLimitSwitch)
+      lightMotion.jog(-1);
+    else if (ZIC_015_MT && !ZIC_015_MH)
+      lightMotion.jog(1);
+    else
+      lightMotion.jog(0);
 
     // save max count to EEPROM as par tof the calibration process
     if (isLightPositionWriteRequest()) {
       lightPositionControlData.maxPulses =
           lightPositionControlData.currentPositionCount;
-      EEPROM.put(EEPROM_LIGHT_POSITION_RAW_MAX_COUNT,
-                 lightPositionControlData.maxPulses);
+      journalLightPosition();
+      configureLightMotion();
     }
-
   } else { // normal oprational mode (not calibrating)
-    lError = lightPositionControlData.pv - lightPositionControlData.setpoint;
-    if (lError > DEFAULT_LIGHT_POSITION_DEADBAND) {
-      lDirection = true; // up
-      lMotorState = true;
-      lightPositionControlData.isControlling = true;
-    } else if (lError < -DEFAULT_LIGHT_POSITION_DEADBAND) {
-      lDirection = false;
-      lMotorState = true;
-      lightPositionControlData.isControlling = true;
-    } else {
-      lMotorState = false;
-      if (lightPositionControlData.isControlling) {
-        *aOutputStream << "************************** SAVE TO EEPROM" << endl;
-        lightPositionControlData.isControlling = false;
-        EEPROM.put(EEPROM_LIGHT_CURRENT_POSITION_RAW_COUNT,
-                   lightPositionControlData.currentPositionCount);
-      }
-    }
+    uint16_t lSetpoint = lightPositionControlData.setpoint > 100
+                             ? 100
+                             : lightPositionControlData.setpoint;
+
+    lightMotion.setTarget((int32_t)(100 - lSetpoint) *
+                          (int32_t)lightPositionControlData.maxPulses / 100);
+  }
+
+  lightMotion.step(lightPositionControlData.currentPositionCount);
+
+  // never drive down into the limit switch
+  lMotorState =
+      lightMotion.getMotorOn() && !(lLimitSwitch && !lightMotion.getDirection());
+  lightEncoder.step(lightPositionControlData.currentPositionCount, lMotorState,
+                    lightMotion.getDirection());
+  // a fault cuts the motor in the same period it is detected
+  if (lightEncoder.isFaulted())
+    lMotorState = false;
+
+  // direction and motor are on the same port, they switch together
+  discreteOutputs.write(DY_CHANNEL_006, lightMotion.getDirection());
+  discreteOutputs.write(DY_CHANNEL_007, lMotorState);
+  discreteOutputs.apply();
+  traceLightChanges();
+
+  if (lightMotion.isSettled()) {
+    journalLightPosition();
+    DA_TRACE(trace, TR_LIGHT_SETTLED,
+             lightPositionControlData.currentPositionCount,
+             lightMotion.getTarget());
+    DA_LOG(logger, DA_LOG_DEBUG, "ZIC_015 pos:%ld pv*10:%d SP:%u max:%lu",
+           (long)lightPositionControlData.currentPositionCount,
+           (int)(lightPositionControlData.pv * 10.0),
+           lightPositionControlData.setpoint,
+           (unsigned long)lightPositionControlData.maxPulses);
   }
-  DY_006.write(lDirection);
-  DY_007.write(lMotorState);
-#if defined(IO_DEBUG)
-  *aOutputStream << "Pos:" << lightPositionControlData.currentPositionCount
-                 << "  0-100:" << lightPositionControlData.pv
-                 << " SP:" << lightPositionControlData.setpoint
-                 << " error:" << lError << " dir:" << lDirection
-                 << " motorState:" << lMotorState
-                 << " ZIC_015_MH:" << ZIC_015_MH << " ZIC_015_SV:" << ZIC_015_SV
-                 << " MaxCount:" << lightPositionControlData.maxPulses << endl;
-#endif
 }
+#endif // if defined(GC_BUILD)
+
 /**
  * [refreshTemperatureUUID refesh 1-wire UUID values to host]
  * @param aModbusAddressLow  [modbus address for lower 16 bits]
@@ -663,6 +935,26 @@ void refreshTemperatureUUID(uint16_t aModbusAddressLow,
   MBSlave.MbData[aModbusAddressHigh + 1] = blconvert.regsl[0];
 }
 
+/**
+ * [refreshTemperatureBlock every 1-Wire slot to host, see HR_TI_BLOCK]
+ */
+void refreshTemperatureBlock() {
+  word *block = &MBSlave.MbData[HR_TI_BLOCK];
+
+  block[0] = DA_MAX_ONE_WIRE_SENSORS;
+  block[1] = temperatureMgr.getBusCount();
+  for (uint8_t i = 0; i < DA_MAX_ONE_WIRE_SENSORS; i++) {
+    const uint8_t *rom = temperatureMgr.oneWireSlotROMs[i];
+    word *romWords = block + 2 + 2 * DA_MAX_ONE_WIRE_SENSORS + 4 * i;
+    bool isEmpty = !temperatureMgr.getUIID(i); // empty slots read 0
+
+    block[2 + i] = temperatureMgr.getTemperatureX10(i);
+    block[2 + DA_MAX_ONE_WIRE_SENSORS + i] = temperatureMgr.getQuality(i);
+    for (uint8_t k = 0; k < 4; k++)
+      romWords[k] = isEmpty ? 0 : rom[2 * k] << 8 | rom[2 * k + 1];
+  }
+}
+
 /**
  * Check for a transition from a coil/digital
  * @param  aCurrentState  [current bit value]
@@ -712,19 +1004,33 @@ void doCheckRestoreDefaults() {
 void doCheckForRescanOneWire() {
   uint8_t bitState = detectTransition(MBSlave.GetBit(CW_CY_002), CY_002);
 
+  // devices are also found in the background, this only searches now
   if (bitState == BIT_RISING_EDGE) {
-    temperatureMgr.scanSensors();
-#if defined(IO_DEBUG)
-    temperatureMgr.serialize(aOutputStream, true);
-#endif // ifdef IO_DEBUG
+    temperatureMgr.requestDiscovery();
+    DA_LOG(logger, DA_LOG_INFO, "1-Wire discovery requested");
   }
   CY_002 = MBSlave.GetBit(CW_CY_002);
 }
 
 void rebootDevice() {
+  DA_LOG(logger, DA_LOG_WARN, "rebooting...");
+  DA_TRACE(trace, TR_REBOOT, MBSlave.MbsWriteCount, KI_001_CV);
 #if defined(IO_DEBUG)
-  *aOutputStream << "rebooting..." << endl;
-#endif                   // ifdef IO_DEBUG
+  // Serial is only begun with IO_DEBUG, flush() would wait on it forever
+  logger.flush();
+  if (isTraceSerial) { // blocking, the ring is lost with the reboot
+    trace.drain(Serial, DA_TRACE_RECORDS * DA_TRACE_FRAME_SIZE);
+    Serial.flush();
+  }
+#endif // ifdef IO_DEBUG
+#if defined(GC_BUILD)
+  lightJournal.flush(); // don't lose the last position
+#else
+  totalizerStore.flush();
+#endif
+  while (hostWritesIndex < sizeof(HostWritesImage))
+    EEPROMServiceHostWrites();
+  EEPROMFlushOneWireMaps();
   wdt_enable(WDTO_15MS); // turn on the WatchDog
 
   for (;;) {
@@ -749,23 +1055,49 @@ bool isLightPositionWriteRequest() {
   lightPositionControlData.previousZIC_015_SV = MBSlave.GetBit(CW_ZIC_015_SV);
   return (bitState == BIT_RISING_EDGE);
 }
+
+bool isLightHomingRequest() {
+  uint8_t bitState =
+      detectTransition(MBSlave.GetBit(CW_ZIC_015_HM),
+                       lightPositionControlData.previousZIC_015_HM);
+  lightPositionControlData.previousZIC_015_HM = MBSlave.GetBit(CW_ZIC_015_HM);
+  return (bitState == BIT_RISING_EDGE);
+}
+
+bool isLightFaultResetRequest() {
+  uint8_t bitState =
+      detectTransition(MBSlave.GetBit(CW_ZIC_015_FR),
+                       lightPositionControlData.previousZIC_015_FR);
+  lightPositionControlData.previousZIC_015_FR = MBSlave.GetBit(CW_ZIC_015_FR);
+  return (bitState == BIT_RISING_EDGE);
+}
 #endif
 
 void refreshHostReads() {
-  MBSlave.MbData[HR_TI_001] = (int)(temperatureMgr.getTemperature(0) * 10.0);
-  MBSlave.MbData[HR_TI_002] = (int)(temperatureMgr.getTemperature(1) * 10.0);
-  MBSlave.MbData[HR_TI_003] = (int)(temperatureMgr.getTemperature(2) * 10.0);
-  MBSlave.MbData[HR_TI_004] = (int)(temperatureMgr.getTemperature(3) * 10.0);
-  MBSlave.MbData[HR_TI_005] = (int)(temperatureMgr.getTemperature(4) * 10.0);
-  MBSlave.MbData[HR_TI_006] = (int)(temperatureMgr.getTemperature(5) * 10.0);
-  MBSlave.MbData[HR_TI_007] = (int)(temperatureMgr.getTemperature(6) * 10.0);
-  MBSlave.MbData[HR_AI_000] = AI_000.getRawSample();
-  MBSlave.MbData[HR_AI_001] = AI_001.getRawSample();
-  MBSlave.MbData[HR_AI_002] = AI_002.getRawSample();
-  MBSlave.MbData[HR_AI_003] = AI_003.getRawSample();
-  MBSlave.MbData[HR_AI_004] = AI_004.getRawSample();
-  MBSlave.MbData[HR_AI_005] = AI_005.getRawSample();
-  MBSlave.MbData[HR_AI_006] = AI_006.getRawSample();
+  MBSlave.MbData[HR_TI_001] = temperatureMgr.getTemperatureX10(0);
+  MBSlave.MbData[HR_TI_002] = temperatureMgr.getTemperatureX10(1);
+  MBSlave.MbData[HR_TI_003] = temperatureMgr.getTemperatureX10(2);
+  MBSlave.MbData[HR_TI_004] = temperatureMgr.getTemperatureX10(3);
+  MBSlave.MbData[HR_TI_005] = temperatureMgr.getTemperatureX10(4);
+  MBSlave.MbData[HR_TI_006] = temperatureMgr.getTemperatureX10(5);
+  MBSlave.MbData[HR_TI_007] = temperatureMgr.getTemperatureX10(6);
+  // low byte DA_ONE_WIRE_* of the last read, high byte failed reads in a row
+  MBSlave.MbData[HR_TI_001_QS] = temperatureMgr.getQuality(0);
+  MBSlave.MbData[HR_TI_002_QS] = temperatureMgr.getQuality(1);
+  MBSlave.MbData[HR_TI_003_QS] = temperatureMgr.getQuality(2);
+  MBSlave.MbData[HR_TI_004_QS] = temperatureMgr.getQuality(3);
+  MBSlave.MbData[HR_TI_005_QS] = temperatureMgr.getQuality(4);
+  MBSlave.MbData[HR_TI_006_QS] = temperatureMgr.getQuality(5);
+  MBSlave.MbData[HR_TI_007_QS] = temperatureMgr.getQuality(6);
+  MBSlave.MbData[HR_TI_CC] = temperatureMgr.getChanges();
+  refreshTemperatureBlock();
+  MBSlave.MbData[HR_AI_000] = analogSampler.getValue(0);
+  MBSlave.MbData[HR_AI_001] = analogSampler.getValue(1);
+  MBSlave.MbData[HR_AI_002] = analogSampler.getValue(2);
+  MBSlave.MbData[HR_AI_003] = analogSampler.getValue(3);
+  MBSlave.MbData[HR_AI_004] = analogSampler.getValue(4);
+  MBSlave.MbData[HR_AI_005] = analogSampler.getValue(5);
+  MBSlave.MbData[HR_AI_006] = analogSampler.getValue(6);
 
 #if defined(NC_BUILD)
 
@@ -792,30 +1124,43 @@ void refreshHostReads() {
   MBSlave.MbData[HR_ZI_015] = (uint16_t)(lightPositionControlData.pv * 10.0);
   MBSlave.MbData[HR_ZI_015_RAW] =
       (uint16_t)(lightPositionControlData.currentPositionCount);
+  MBSlave.MbData[HR_ZI_015_ST] = lightEncoder.getStatus();
+  MBSlave.MbData[HR_ZI_015_V] = (int16_t)lightEncoder.getVelocity();
+  MBSlave.MbData[HR_ZI_015_HS] = lightHoming.getStatus();
+  blconvert.val = lightPositionControlData.maxPulses;
+  MBSlave.MbData[HR_ZI_015_MX] = blconvert.regsl[1];
+  MBSlave.MbData[HR_ZI_015_MX + 1] = blconvert.regsl[0];
 
 //  SCD30Sensor.serialize(aOutputStream,true);
 
 #endif // if defined(NC_BUILD)
 
-  MBSlave.SetBit(CS_DI_000, DI_000.getSample());
-  MBSlave.SetBit(CS_DI_001, DI_001.getSample());
-  MBSlave.SetBit(CS_DI_002, DI_002.getSample());
-  MBSlave.SetBit(CS_DI_003, DI_003.getSample());
-  MBSlave.SetBit(CS_DI_004, DI_004.getSample());
-  MBSlave.SetBit(CS_DI_005, DI_005.getSample());
-  MBSlave.SetBit(CS_DI_006, DI_006.getSample());
-  MBSlave.SetBit(CS_DI_007, DI_007.getSample());
-  MBSlave.SetBit(CS_DI_008, DI_008.getSample());
-  MBSlave.SetBit(CS_DI_009, DI_009.getSample());
-
 #if not defined(GC_BUILD)
   MBSlave.MbData[HR_XT_006_RW] = XT_006.getCurrentPulses();
   MBSlave.MbData[HR_XT_007_RW] = XT_007.getCurrentPulses();
+
+  // pulse frequency mHz, from the pulse period at low flow
+  blconvert.val = XT_006.getFrequency();
+  MBSlave.MbData[HR_XT_006_HZ] = blconvert.regsl[1];
+  MBSlave.MbData[HR_XT_006_HZ + 1] = blconvert.regsl[0];
+  blconvert.val = XT_007.getFrequency();
+  MBSlave.MbData[HR_XT_007_HZ] = blconvert.regsl[1];
+  MBSlave.MbData[HR_XT_007_HZ + 1] = blconvert.regsl[0];
+
+  // totals in pulses, survive reboots
+  blconvert.val = flowTotals[0];
+  MBSlave.MbData[HR_XT_006_TOT] = blconvert.regsl[1];
+  MBSlave.MbData[HR_XT_006_TOT + 1] = blconvert.regsl[0];
+  blconvert.val = flowTotals[1];
+  MBSlave.MbData[HR_XT_007_TOT] = blconvert.regsl[1];
+  MBSlave.MbData[HR_XT_007_TOT + 1] = blconvert.regsl[0];
 #endif
 
   // watchdog current value
   MBSlave.MbData[HR_KI_001] = KI_001_CV;
 
+  MBSlave.MbData[HR_KI_002] = isHostSynced ? KI_002_HOST_SYNCED : 0;
+
   // App major/minor/patch
   MBSlave.MbData[HR_KI_003] = KI_003;
 
@@ -885,33 +1230,21 @@ void processHostWrites() {
   // drive DOs from master values
   // Relays
 
-  DY_000.write(MBSlave.GetBit(CW_DY_000));
-  DY_001.write(MBSlave.GetBit(CW_DY_001));
-  DY_002.write(MBSlave.GetBit(CW_DY_002));
-  DY_003.write(MBSlave.GetBit(CW_DY_003));
-  DY_004.write(MBSlave.GetBit(CW_DY_004));
-  DY_005.write(MBSlave.GetBit(CW_DY_005));
-#if not defined(GC_BUILD)
-  DY_006.write(MBSlave.GetBit(CW_DY_006));
-  DY_007.write(MBSlave.GetBit(CW_DY_007));
-#endif
-  DY_008.write(MBSlave.GetBit(CW_DY_008));
-  DY_009.write(MBSlave.GetBit(CW_DY_009));
-  DY_010.write(MBSlave.GetBit(CW_DY_010));
-  DY_011.write(MBSlave.GetBit(CW_DY_011));
-  DY_012.write(MBSlave.GetBit(CW_DY_012));
-  DY_013.write(MBSlave.GetBit(CW_DY_013));
-  DY_014.write(MBSlave.GetBit(CW_DY_014));
-  DY_015.write(MBSlave.GetBit(CW_DY_015));
-  DY_016.write(MBSlave.GetBit(CW_DY_016));
-  DY_017.write(MBSlave.GetBit(CW_DY_017));
-  DY_021.write(MBSlave.GetBit(CW_DY_021));
-#if not defined(NC_BUILD)
-  DY_018.write(MBSlave.GetBit(CW_DY_018));
-  DY_019.write(MBSlave.GetBit(CW_DY_019));
-  DY_020.write(MBSlave.GetBit(CW_DY_020));
+  // the 22 DO coils as one image, one port write per changed port
+  uint32_t lCoils = (uint32_t)MBSlave.MbData[CW_DY_000 / 16 + 1] << 16 |
+                    MBSlave.MbData[CW_DY_000 / 16];
 
-#endif // if not defined(NC_BUILD)
+  discreteOutputs.writeImage(lCoils, DY_HOST_MASK);
+  discreteOutputs.apply();
+
+  // AI filter stages, 0 = raw
+  analogSampler.setFilterConfig(0, MBSlave.MbData[HW_AI_000_CF]);
+  analogSampler.setFilterConfig(1, MBSlave.MbData[HW_AI_001_CF]);
+  analogSampler.setFilterConfig(2, MBSlave.MbData[HW_AI_002_CF]);
+  analogSampler.setFilterConfig(3, MBSlave.MbData[HW_AI_003_CF]);
+  analogSampler.setFilterConfig(4, MBSlave.MbData[HW_AI_004_CF]);
+  analogSampler.setFilterConfig(5, MBSlave.MbData[HW_AI_005_CF]);
+  analogSampler.setFilterConfig(6, MBSlave.MbData[HW_AI_006_CF]);
 
   // Drive AOs from master values
   AY_000.writeAO(MBSlave.MbData[HW_AY_000]);
@@ -920,6 +1253,8 @@ void processHostWrites() {
   AY_001.writeAO(MBSlave.MbData[HW_AY_001]);
 #if defined(GC_BUILD)
   lightPositionControlData.setpoint = MBSlave.MbData[HW_ZIC_015_SP];
+  if (MBSlave.MbData[HW_ZIC_015_SZ] != lightPositionControlData.slowdownZone)
+    configureLightMotion();
 #endif
   // DO TImer presets controllino: Active High reverse
 
@@ -956,6 +1291,9 @@ void processHostWrites() {
   doCheckRestoreDefaults();
   doCheckForRescanOneWire();
   doCheckRebootDevice();
+#if not defined(GC_BUILD)
+  doCheckTotalizerResets();
+#endif
 }
 
 void EEPROMWriteCurrentIPs() {
@@ -970,8 +1308,35 @@ void EEPROMWriteCurrentIPs() {
   EEPROM.put(EEPROM_MAC_ADDR, currentMAC);
 }
 
-void EEPromWriteOneWireMaps() {
-  EEPROM.put(EEPROM_ONE_WIRE_MAP, temperatureMgr.oneWireTemperatureMap);
+/**
+ * [EEPromWriteOneWireMaps save the 1-Wire slot ROM codes]
+ * only marks them, the eeprom task writes them, see
+ * EEPROMServiceOneWireMaps(). A remap during the write starts it again
+ */
+void EEPromWriteOneWireMaps() { oneWireMapsIndex = 0; }
+
+/**
+ * [EEPROMServiceOneWireMaps write one byte of the slot ROM codes]
+ * straight from temperatureMgr, only when the EEPROM is idle
+ */
+void EEPROMServiceOneWireMaps() {
+  if (oneWireMapsIndex >= sizeof(temperatureMgr.oneWireSlotROMs))
+    return;
+#if !defined(HOST_BUILD)
+  if (!eeprom_is_ready())
+    return;
+#endif
+
+  EEPROM.update(EEPROM_ONE_WIRE_ROMS + oneWireMapsIndex,
+                ((const uint8_t *)temperatureMgr.oneWireSlotROMs)
+                    [oneWireMapsIndex]);
+  oneWireMapsIndex++;
+}
+
+// blocking, before the ROMs are read back or a reboot
+void EEPROMFlushOneWireMaps() {
+  while (oneWireMapsIndex < sizeof(temperatureMgr.oneWireSlotROMs))
+    EEPROMServiceOneWireMaps();
 }
 
 void printByteArray(uint8_t anArray[], uint8_t aSize, Stream *aOutputStream) {
@@ -1014,19 +1379,9 @@ void EEPROMLoadConfig()
   currentSubnet = temp32;
 
   EEPROM.get(EEPROM_MAC_ADDR, currentMAC);
-  EEPROM.get(EEPROM_ONE_WIRE_MAP, temperatureMgr.oneWireTemperatureMap);
-
-  EEPROM.get(EEPROM_LIGHT_POSITION_RAW_MAX_COUNT,
-             lightPositionControlData.maxPulses);
-
-  EEPROM.get(EEPROM_LIGHT_CURRENT_POSITION_RAW_COUNT, temp32);
-  lightPosition.write(temp32);
+  EEPROM.get(EEPROM_ONE_WIRE_ROMS, temperatureMgr.oneWireSlotROMs);
 
 #if defined(IO_DEBUG)
-  *aOutputStream << "maxLightPulses:" << lightPositionControlData.maxPulses
-                 << endl;
-                 *aOutputStream << "temp32:" << temp32
-                                << endl;
   *aOutputStream << "currentIP:" << currentIP << endl;
   *aOutputStream << "currentGateway:" << currentGateway << endl;
   *aOutputStream << "currentSubnet:" << currentSubnet << endl;
@@ -1035,6 +1390,84 @@ void EEPROMLoadConfig()
 #endif // ifdef IO_DEBUG
 }
 
+/**
+ * [EEPROMLoadLightPosition restore encoder count and travel, setup() only]
+ * the journal ring and the encoder are only set at boot, a restore of the
+ * defaults sets maxPulses itself
+ */
+void EEPROMLoadLightPosition() {
+#if defined(GC_BUILD)
+  int32_t lPosition;
+
+  // newest journal record, the fixed cells only until the first one exists
+  if (!lightJournal.load(lPosition, lightPositionControlData.maxPulses)) {
+    EEPROM.get(EEPROM_LIGHT_POSITION_RAW_MAX_COUNT,
+               lightPositionControlData.maxPulses);
+    EEPROM.get(EEPROM_LIGHT_CURRENT_POSITION_RAW_COUNT, lPosition);
+  }
+  lightPosition.write(lPosition);
+  DA_LOG(logger, DA_LOG_INFO, "maxLightPulses:%lu position:%ld",
+         (unsigned long)lightPositionControlData.maxPulses, (long)lPosition);
+#endif
+}
+
+/**
+ * [EEPROMLoadHostWrites restore host written outputs and setpoints]
+ * only the coils in HOST_WRITES_COIL_MASK_x are restored, one shot
+ * commands stay 0
+ */
+void EEPROMLoadHostWrites() {
+  HostWritesImage image;
+  const uint16_t coilMasks[HOST_WRITES_COIL_WORDS] = {
+      HOST_WRITES_COIL_MASK_0, HOST_WRITES_COIL_MASK_1,
+      HOST_WRITES_COIL_MASK_2};
+
+  EEPROM.get(EEPROM_HOST_WRITES_ADDR, image);
+  if (image.flag != EEPROM_HOST_WRITES_SAVED)
+    return;
+
+  for (uint8_t i = 0; i < HOST_WRITES_COIL_WORDS; i++)
+    MBSlave.MbData[i] = image.coils[i] & coilMasks[i];
+  for (uint8_t i = 0; i < HOST_WRITES_REGISTER_COUNT; i++)
+    MBSlave.MbData[HOST_WRITES_REGISTER_START + i] = image.registers[i];
+
+  DA_LOG(logger, DA_LOG_INFO, "restored host writes SP:%u",
+         MBSlave.MbData[HW_ZIC_015_SP]);
+}
+
+/**
+ * [EEPROMWriteHostWrites stage host written outputs and setpoints]
+ * the eeprom task writes the image, see EEPROMServiceHostWrites(). A save
+ * staged over one in progress starts again from the first byte
+ * @param aContext [ unused, wheel timer callback ]
+ */
+void EEPROMWriteHostWrites(void *aContext) {
+  hostWritesImage.flag = EEPROM_HOST_WRITES_SAVED;
+  for (uint8_t i = 0; i < HOST_WRITES_COIL_WORDS; i++)
+    hostWritesImage.coils[i] = MBSlave.MbData[i];
+  for (uint8_t i = 0; i < HOST_WRITES_REGISTER_COUNT; i++)
+    hostWritesImage.registers[i] =
+        MBSlave.MbData[HOST_WRITES_REGISTER_START + i];
+  hostWritesIndex = 0;
+}
+
+/**
+ * [EEPROMServiceHostWrites write one byte of the staged host writes]
+ * only when the EEPROM is idle, update() skips bytes that did not change
+ */
+void EEPROMServiceHostWrites() {
+  if (hostWritesIndex >= sizeof(HostWritesImage))
+    return;
+#if !defined(HOST_BUILD)
+  if (!eeprom_is_ready())
+    return;
+#endif
+
+  EEPROM.update(EEPROM_HOST_WRITES_ADDR + hostWritesIndex,
+                ((const uint8_t *)&hostWritesImage)[hostWritesIndex]);
+  hostWritesIndex++;
+}
+
 void EEPROMWriteDefaultConfig() {
   uint8_t configFlag = EEPROM_CONFIGURED;
 
@@ -1050,8 +1483,20 @@ void EEPROMWriteDefaultConfig() {
   EEPROM.put(EEPROM_MAC_ADDR, defaultMAC);
   temperatureMgr.resetMaps();
   EEPromWriteOneWireMaps();
+  EEPROMFlushOneWireMaps(); // EEPROMLoadConfig() reads them back
   EEPROM.put(EEPROM_LIGHT_POSITION_RAW_MAX_COUNT,
              DEFAULT_MAX_PULSE_COUNT_LIGHT_POSITION);
+#if defined(GC_BUILD)
+  // the journal outranks the fixed cells, it needs the default as well
+  lightJournal.append(lightPosition.read(),
+                      DEFAULT_MAX_PULSE_COUNT_LIGHT_POSITION);
+  // written now, on a new part setup() loads it straight back and the
+  // fixed position cell has never been written
+  lightJournal.flush();
+  lightPositionControlData.maxPulses = DEFAULT_MAX_PULSE_COUNT_LIGHT_POSITION;
+#endif
+  hostWritesIndex = sizeof(HostWritesImage); // drop a pending save
+  EEPROM.update(EEPROM_HOST_WRITES_ADDR, 0);  // forget host writes
 }
 
 void remoteAtlasCommandHandler(uint8_t argc, char **argv,
@@ -1148,6 +1593,114 @@ void remoteDeviceCommandHandler(uint8_t argc, char **argv,
       *aOutputStream << F("Unrecognized format for command") << endl;
     break;
 
+  case 't':
+#if defined(MGS_MODBUS_STATS)
+    if (argc == 1) {
+      MbsStatistics &stats = MBSlave.MbsStats;
+      *aOutputStream << F("requests:") << stats.requests
+                     << F(" bytesIn:") << stats.bytesIn
+                     << F(" bytesOut:") << stats.bytesOut
+                     << F(" bytesCopied:") << stats.bytesCopied
+                     << F(" busyMicros:") << stats.busyMicros
+                     << F(" maxMicros:") << stats.maxMicros
+                     << F(" cyclesPerMicro:") << (F_CPU / 1000000UL) << endl;
+    } else if (argc == 2 && argv[1][0] == 'r') {
+      MBSlave.MbsResetStats();
+      *aOutputStream << F("Modbus statistics reset") << endl;
+    } else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+#else
+    *aOutputStream << F("Modbus statistics not enabled (MGS_MODBUS_STATS)")
+                   << endl;
+#endif
+    break;
+
+  case 'a':
+    if (argc == 1)
+      analogSampler.serialize(aOutputStream, true);
+    else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
+  case 'n':
+    if (argc == 1)
+      discreteInputs.serialize(aOutputStream, true);
+    else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
+  case 'o':
+    if (argc == 1)
+      discreteOutputs.serialize(aOutputStream, true);
+    else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
+  case 'f':
+#if not defined(GC_BUILD)
+    if (argc == 1) {
+      XT_006.serialize(aOutputStream, true);
+      XT_007.serialize(aOutputStream, true);
+      totalizerStore.serialize(aOutputStream, false);
+      *aOutputStream << F(" totals:") << flowTotals[0] << ","
+                     << flowTotals[1] << endl;
+    } else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+#else
+    *aOutputStream << F("No flow meters on this device") << endl;
+#endif
+    break;
+
+  case 'l':
+#if defined(GC_BUILD)
+    if (argc == 1) {
+      lightMotion.serialize(aOutputStream, true);
+      lightEncoder.serialize(aOutputStream, true);
+      lightJournal.serialize(aOutputStream, true);
+      lightHoming.serialize(aOutputStream, true);
+    } else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+#else
+    *aOutputStream << F("No light positioner on this device") << endl;
+#endif
+    break;
+
+  case 'v':
+    if (argc == 2)
+      logger.setLevel(atoi(argv[1]));
+    if (argc <= 2)
+      logger.serialize(aOutputStream, true);
+    else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
+  case 'x':
+    // frames are binary, pipe the session through tools/tracedecode
+    if (argc == 3 && argv[1][0] == 'e')
+      trace.setEnabled(atoi(argv[2]));
+    else if (argc == 3 && argv[1][0] == 's')
+      isTraceSerial = atoi(argv[2]);
+    if (argc == 1 || argc == 3) {
+      trace.serialize(aOutputStream, false);
+      *aOutputStream << F(" serial:") << isTraceSerial << endl;
+      if (argc == 1)
+        trace.drain(*aOutputStream, DA_TRACE_RECORDS * DA_TRACE_FRAME_SIZE);
+    } else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
+  case 'k':
+    if (argc == 1) {
+      scheduler.serialize(aOutputStream, true);
+      *aOutputStream << F("timer wheel maxBacklog:")
+                     << timerWheel.getMaxBacklog() << endl;
+    } else if (argc == 2 && argv[1][0] == 'r') {
+      scheduler.resetStats();
+      *aOutputStream << F("Task statistics reset") << endl;
+    } else
+      *aOutputStream << F("Unrecognized format for command") << endl;
+    break;
+
   default:
     *aOutputStream << F("Invalid Command for Remote") << endl;
   }
@@ -1188,11 +1741,29 @@ void remoteHelpCommandHandler(uint8_t argc, char **argv,
   *aOutputStream << F("remote m <MAC> TODO ") << endl;
   *aOutputStream << F("  Reset to Defaults:");
   *aOutputStream << F("remote r") << endl;
+  *aOutputStream << F("  Display/Reset Modbus Statistics:");
+  *aOutputStream << F(" remote t [r]") << endl;
+  *aOutputStream << F("  Display Analog Sampler:");
+  *aOutputStream << F(" remote a") << endl;
+  *aOutputStream << F("  Display Discrete Input Scanner:");
+  *aOutputStream << F(" remote n") << endl;
+  *aOutputStream << F("  Display Discrete Output Bank:");
+  *aOutputStream << F(" remote o") << endl;
+  *aOutputStream << F("  Display Flow Meters:");
+  *aOutputStream << F(" remote f") << endl;
+  *aOutputStream << F("  Display Light Positioner:");
+  *aOutputStream << F(" remote l") << endl;
+  *aOutputStream << F("  Display Debug Log/Set Level 0=E 1=W 2=I 3=D:");
+  *aOutputStream << F(" remote v [level]") << endl;
+  *aOutputStream << F("  Dump Binary Trace/Enable/Stream on Serial:");
+  *aOutputStream << F(" remote x [e|s 0|1]") << endl;
+  *aOutputStream << F("  Display/Reset Task Scheduler Statistics:");
+  *aOutputStream << F(" remote k [r]") << endl;
 
   *aOutputStream << F("1-Wire Group") << endl;
   *aOutputStream << F("  Display Current 1-Wire Info:");
   *aOutputStream << F(" 1wire d ") << endl;
-  *aOutputStream << F("  Map 1-Wire Temperature x to sensore position y:");
+  *aOutputStream << F("  Move 1-Wire probe in slot/ROM code y to slot x:");
   *aOutputStream << F(" 1wire m <x> <y>") << endl;
 }
 
@@ -1204,16 +1775,29 @@ void remoteOneWireCommandHandler(uint8_t argc, char **argv,
   switch (command) {
   case 'm':
 
+    // y is a slot from 1wire d, or a 16 hex digit ROM code as shown there
     if (argc == 3) {
       uint8_t x = atoi(argv[1]);
-      uint8_t y = atoi(argv[2]);
+      bool isMapped;
+
+      if (strlen(argv[2]) == 16) {
+        uint8_t rom[8];
+        char digits[3] = {0};
+
+        for (uint8_t i = 0; i < 8; i++) {
+          memcpy(digits, argv[2] + i * 2, 2);
+          rom[i] = strtoul(digits, NULL, 16);
+        }
+        isMapped = temperatureMgr.mapSensorROM(x, rom);
+      } else
+        isMapped = temperatureMgr.mapSensor(x, (uint8_t)atoi(argv[2]));
 
-      if (temperatureMgr.mapSensor(x, y)) {
+      if (isMapped) {
         EEPromWriteOneWireMaps();
         temperatureMgr.serialize(aOutputStream, true);
       } else
         *aOutputStream << F("x and|or y out of range:") << " x:" << x
-                       << " y:" << y << endl;
+                       << " y:" << argv[2] << endl;
     } else
       *aOutputStream << F("Unrecongized format for command") << endl;
     break;
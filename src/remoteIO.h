@@ -33,6 +33,13 @@
 
 #define IO_DEBUG
 //#undef IO_DEBUG
+#if defined(IO_DEBUG)
+#define DEFAULT_LOG_LEVEL DA_LOG_DEBUG // DA_Logger, remote v <level>
+#else
+#define DEFAULT_LOG_LEVEL DA_LOG_WARN
+#endif
+#define DEFAULT_TRACE_SERIAL false // DA_Trace frames with the log, remote x s 1
+#define LOG_REPEAT_INTERVAL 1000   // ms, DA_LOG_EVERY sites that can repeat fast
 #define APP_BUILD_DATE 1529013511L
 
 // detecting modbuss coil  change
@@ -52,12 +59,34 @@
 #define DEFAULT_PENDING_MAC_ADDRESS 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 #define DEFAULT_MODBUSBUS_PORT 502
 #define DEFAULT_ANALOG_POLL_RATE 2                   // seconds
+#define ANALOG_INPUT_COUNT 7          // AI_000..AI_006 on ADC0..ADC6
+#define DEFAULT_ADC_SAMPLE_DIVIDER 1  // keep every nth conversion, ~139 Hz/AI
 #define DEFAULT_DI_DEBOUNCE_TIME 50                  // ms
 #define DEFAULT_1WIRE_POLLING_INTERVAL 5000          // ms
+#define DEFAULT_1WIRE_DISCOVERY_INTERVAL 30000       // ms, hot plug search
 #define DEFAULT_ATLAS_POLLING_INTERVAL 3000          // ms
 #define DEFAULT_SC30_POLLING_INTERVAL 5000           // ms
 #define DEFAULT_MAX_PULSE_COUNT_LIGHT_POSITION 34115 // determined emperically
 #define DEFAULT_LIGHT_POSITION_DEADBAND 0.15          // %
+#define DEFAULT_LIGHT_SLOWDOWN_ZONE 30 // 0.1 % of travel, HW_ZIC_015_SZ = 0
+
+// light positioner motion profile, see DA_MotionController
+#define LIGHT_MOTION_PERIOD 10          // ms, KI_010
+#define LIGHT_MOTION_RAMP_TIME 1000     // ms to full drive
+#define LIGHT_MOTION_COAST_TIME 150     // ms, motor cut ahead by v * coast
+#define LIGHT_MOTION_REVERSE_DELAY 300  // ms off before reversing
+#define LIGHT_MOTION_PULSE_WINDOW 500   // ms, relay pulsed drive below 100 %
+#define LIGHT_MOTION_MIN_DRIVE 20       // %
+#define LIGHT_STALL_TIME 1000           // ms motor on without a count
+#define LIGHT_MISMATCH_COUNTS 200       // counts against the direction
+
+// light positioner homing, CW_ZIC_015_HM. The top end is found by the
+// counts stopping, LIGHT_HOMING_END_TIME has to be < LIGHT_STALL_TIME
+#define LIGHT_HOMING_PASSES 3
+#define LIGHT_HOMING_END_TIME 500     // ms without counts at the top
+#define LIGHT_HOMING_TIMEOUT 60000    // ms per leg
+#define LIGHT_HOMING_MIN_TRAVEL 10000 // counts, shorter is a jam
+#define LIGHT_HOMING_TOLERANCE 10     // per mille, outlier rejection
 
 // EEPROM addresses
 #define EEPROM_CONFIGURED 2        // this value stored at address
@@ -67,31 +96,114 @@
 #define EEPROM_GATEWAY_ADDR EEPROM_IP_ADDR + sizeof(uint32_t)
 #define EEPROM_SUBNET_ADDR EEPROM_GATEWAY_ADDR + sizeof(uint32_t)
 #define EEPROM_MAC_ADDR EEPROM_SUBNET_ADDR + sizeof(uint32_t)
-#define EEPROM_ONE_WIRE_MAP EEPROM_MAC_ADDR + 6
+#define EEPROM_ONE_WIRE_MAP EEPROM_MAC_ADDR + 6 // unused, was the index map
 #define EEPROM_LIGHT_POSITION_RAW_MAX_COUNT EEPROM_ONE_WIRE_MAP + sizeof(uint8_t) * 7
 #define EEPROM_LIGHT_CURRENT_POSITION_RAW_COUNT EEPROM_LIGHT_POSITION_RAW_MAX_COUNT + sizeof(uint32_t)
+#define EEPROM_HOST_WRITES_ADDR EEPROM_LIGHT_CURRENT_POSITION_RAW_COUNT + sizeof(uint32_t)
+#define EEPROM_TOTALIZER_ADDR EEPROM_HOST_WRITES_ADDR + sizeof(HostWritesImage)
+#define EEPROM_TOTALIZER_SLOTS 16 // DA_TotalizerStore ring, 11 bytes each
+#define EEPROM_LIGHT_JOURNAL_ADDR                                              \
+  EEPROM_TOTALIZER_ADDR + EEPROM_TOTALIZER_SLOTS * sizeof(DA_TotalizerSlot)
+#define EEPROM_LIGHT_JOURNAL_SLOTS 32 // DA_PositionJournal, 11 bytes each
+#define EEPROM_ONE_WIRE_ROMS                                                   \
+  EEPROM_LIGHT_JOURNAL_ADDR +                                                  \
+      EEPROM_LIGHT_JOURNAL_SLOTS * sizeof(DA_JournalRecord) // 8 bytes per slot
 #define HEART_BEAT_PERIOD 5000 // ms
 
+// flow totalizers: checkpointed to the EEPROM ring while flow changes them
+#define TOTALIZER_CHECKPOINT_PERIOD 900000UL // ms, 15 min
+#define TOTALIZER_RESET_SAVE_DELAY 10000     // ms after a reset coil
+
+// fast boot: host written outputs/setpoints are restored from EEPROM and
+// light control holds until the host writes or the timeout expires
+#define HOST_SYNC_TIMEOUT 10000        // ms
+#define HOST_WRITES_SAVE_DELAY 2000    // ms after the last host write
+#define EEPROM_HOST_WRITES_SAVED 0xA6  // HostWritesImage flag when valid
+#define HOST_WRITES_COIL_WORDS 3       // coils 0..47
+#define HOST_WRITES_REGISTER_START HW_AY_000 // HW_AY_000..HW_ZIC_015_SZ
+#define HOST_WRITES_REGISTER_COUNT 11
+// coils restored on boot: DY_000..DY_021 and TI_001..TI_007 enables. The
+// one shot commands (CY_) and light position modes are never restored
+#define HOST_WRITES_COIL_MASK_0 0xFFFF // coils 0-15
+#define HOST_WRITES_COIL_MASK_1 0xF03F // coils 16-31
+#define HOST_WRITES_COIL_MASK_2 0x0007 // coils 32-47
+
+// HR_KI_002 Remote I/O status bits
+#define KI_002_HOST_SYNCED 0x0001 // host wrote since boot or sync timed out
+
+// loop() task scheduler: period ms (0 = every pass), priority (0 = highest)
+// and CPU budget us per run. Periods run off the Timer2 timer wheel
+#define TASK_NETWORK_PERIOD 0
+#define TASK_NETWORK_PRIORITY 0
+#define TASK_NETWORK_BUDGET 1500
+#define TASK_COMMANDS_PERIOD 20
+#define TASK_COMMANDS_PRIORITY 1
+#define TASK_COMMANDS_BUDGET 500
+#define TASK_DISCRETE_INPUTS_PERIOD (DEFAULT_DI_DEBOUNCE_TIME / 4) // 4 scans
+#define TASK_DISCRETE_INPUTS_PRIORITY 3
+#define TASK_DISCRETE_INPUTS_BUDGET 200
+#define TASK_HOST_READS_PERIOD 50
+#define TASK_HOST_READS_PRIORITY 4
+#define TASK_HOST_READS_BUDGET 800
+#define TASK_EEPROM_PERIOD 0 // EEPROM byte writes take 3.3 ms, poll often
+#define TASK_EEPROM_PRIORITY 5
+#define TASK_EEPROM_BUDGET 50
+#define TASK_ANALOGS_PERIOD 10 // drain the ADC ring before it fills (32 ms)
+#define TASK_ANALOGS_PRIORITY 6
+#define TASK_ANALOGS_BUDGET 100
+#define TASK_ONE_WIRE_PERIOD 50 // one scratchpad read (~11 ms) per run
+#define TASK_ONE_WIRE_PRIORITY 7
+#define TASK_ONE_WIRE_BUDGET 12000
+#define TASK_SERIAL_SENSORS_PERIOD 100
+#define TASK_SERIAL_SENSORS_PRIORITY 8
+#define TASK_SERIAL_SENSORS_BUDGET 2000
+#define TASK_LOG_PERIOD 10 // 19200 baud empties the 64 byte TX buffer in 33 ms
+#define TASK_LOG_PRIORITY 9
+#define TASK_LOG_BUDGET 200
+#define TASK_PASS_BUDGET 2000 // us of periodic work per loop() pass
+
+// simavr benchmark build: Modbus/TCP (MBAP) frames over a UART
+#define SIMAVR_BENCH_MODBUS_PORT Serial1
+#define SIMAVR_BENCH_MODBUS_BAUD 115200
+
 // flow meter constants
 #define FLOW_CALC_PERIOD_SECONDS 1 // flow rate calc period s
 
+// high rate meters (kHz) can be counted by a 16 bit timer instead of the
+// pin interrupt, the meter is then wired to T5 (pin 47) or T4 (PH7), see
+// DA_TimerFlowCounter
+//#define XT006_TIMER_COUNTER 5
+//#define XT007_TIMER_COUNTER 4
+
 #define XT006_SENSOR_INTERUPT_PIN CONTROLLINO_SCREW_TERMINAL_INT_00
 
+#if defined(XT006_TIMER_COUNTER)
+#define ENABLE_XT006_SENSOR_INTERRUPTS()
+#define DISABLE_XT006_SENSOR_INTERRUPTS()
+#else
 #define ENABLE_XT006_SENSOR_INTERRUPTS()                                       \
   attachInterrupt(digitalPinToInterrupt(XT006_SENSOR_INTERUPT_PIN),            \
                   onXT_006_PulseIn, RISING)
 #define DISABLE_XT006_SENSOR_INTERRUPTS()                                      \
   detachInterrupt(digitalPinToInterrupt(XT006_SENSOR_INTERUPT_PIN))
+#endif
 
 #define XT007_SENSOR_INTERUPT_PIN CONTROLLINO_SCREW_TERMINAL_INT_01
+#if defined(XT007_TIMER_COUNTER)
+#define ENABLE_XT007_SENSOR_INTERRUPTS()
+#define DISABLE_XT007_SENSOR_INTERRUPTS()
+#else
 #define ENABLE_XT007_SENSOR_INTERRUPTS()                                       \
   attachInterrupt(digitalPinToInterrupt(XT007_SENSOR_INTERUPT_PIN),            \
                   onXT_007_PulseIn, RISING)
 #define DISABLE_XT007_SENSOR_INTERRUPTS()                                      \
-  detachInterrupt(digitalPinToInterrupt(XT006_SENSOR_INTERUPT_PIN))
+  detachInterrupt(digitalPinToInterrupt(XT007_SENSOR_INTERUPT_PIN))
+#endif
 
 // one wire constants
 #define WIRE_BUS_PIN 20 // pin
+// one DA_OneWireTemperatureMgr bus per pin, up to DA_MAX_ONE_WIRE_BUSES
+#define ONE_WIRE_BUS_PINS {WIRE_BUS_PIN}
 #define ONE_TEMPERATURE_PRECISION 9
 
 // discrete oupute timer defaults
@@ -112,6 +224,20 @@
 #define CS_XT_006 107 // Flow Indicator (0-24V) Interrupt Not useful on its own
 #define CS_XT_007 108 // Flow Indicator (0-24V) Interrupt Not useful on its own
 
+// discrete input scanner channels, DI_000..DI_009 are channels 0..9
+#define DI_CHANNEL_007 7  // light position home limit switch (GC)
+#define CI_CHANNEL_001 10 // restore defaults (hard)
+#define DI_CHANNEL_MASK 0x03FFU // channels published to CS_DI_000..009
+
+// discrete output bank channels, DY_000..DY_021 are channels 0..21
+#define DY_CHANNEL_006 6 // light position motor direction (GC)
+#define DY_CHANNEL_007 7 // light position motor on (GC)
+#if defined(GC_BUILD)
+#define DY_HOST_MASK 0x003FFF3FUL // light control owns DY_006/DY_007
+#else
+#define DY_HOST_MASK 0x003FFFFFUL // CW_DY_000..CW_DY_021
+#endif
+
 #define CW_DY_000 0      // Relay Output 0
 #define CW_DY_001 1      // Relay Output 1
 #define CW_DY_002 2      // Relay Output 2
@@ -151,6 +277,10 @@
 #define CW_ZIC_015_MT 36 // LIGHT POSITION MOVE TO TOP (=1)
 #define CW_ZIC_015_SV 37 // LIGHT POSITION CONTROLLER SAVE MAX COUNT (=1)
 #define CW_ZIC_015_CL 38   // LIGHT POSITION CONTROLLER CALIBRATION MODE  (=1)
+#define CW_XT_006_RS 39    // Reset Flow Totalizer XT_006 (=1)
+#define CW_XT_007_RS 40    // Reset Flow Totalizer XT_007 (=1)
+#define CW_ZIC_015_FR 41   // LIGHT POSITION FAULT RESET (=1)
+#define CW_ZIC_015_HM 42   // LIGHT POSITION HOME AND CALIBRATE TRAVEL (=1)
 
 #define HR_TI_001 20     // 1-Wire Temperature 1
 #define HR_TI_002 21     // 1-Wire Temperature 2
@@ -159,7 +289,7 @@
 #define HR_TI_005 24     // 1-Wire Temperature 5
 #define HR_TI_006 25     // 1-Wire Temperature 6
 #define HR_TI_007 26     // 1-Wire Temperature 7
-#define HR_AI_000 27     // Analog Input 0 Value Raw/Scaled  (0-24V)
+#define HR_AI_000 27     // Analog Input 0 Value Raw/Filtered (0-24V)
 #define HR_AI_001 28     // Analog Input 1 Value Raw/Scaled  (0-24V)
 #define HR_AI_002 29     // Analog Input 2 Value Raw/Scaled  (0-24V)
 #define HR_AI_003 30     // Analog Input 3 Value Raw/Scaled  (0-24V)
@@ -179,6 +309,22 @@
 #define HR_XT_007_RW 44  // Flow Indicator RAW Pulse Per Second
 #define HR_ZI_015 45     // LIGHT POSITION 0-100 % * 10
 #define HR_ZI_015_RAW 46 // LIGHT POSITION RAW COUNT
+#define HR_ZI_015_ST 47  // LIGHT POSITION STATUS, DA_ENCODER_* bits
+#define HR_ZI_015_V 48   // LIGHT POSITION VELOCITY counts/s (signed)
+#define HR_ZI_015_HS 49  // LIGHT POSITION HOMING STATUS, DA_HomingSequence
+#define HR_XT_006_HZ 60  // Flow Indicator Pulse Frequency mHz (32 bit)
+#define HR_XT_007_HZ 62  // Flow Indicator Pulse Frequency mHz (32 bit)
+#define HR_XT_006_TOT 64 // Flow Totalizer pulses (32 bit)
+#define HR_XT_007_TOT 66 // Flow Totalizer pulses (32 bit)
+#define HR_ZI_015_MX 68  // LIGHT POSITION CALIBRATED TRAVEL counts (32 bit)
+#define HR_TI_001_QS 70  // 1-Wire Temperature 1 Quality, DA_OneWireTemperatureMgr
+#define HR_TI_002_QS 71  // 1-Wire Temperature 2 Quality
+#define HR_TI_003_QS 72  // 1-Wire Temperature 3 Quality
+#define HR_TI_004_QS 73  // 1-Wire Temperature 4 Quality
+#define HR_TI_005_QS 74  // 1-Wire Temperature 5 Quality
+#define HR_TI_006_QS 75  // 1-Wire Temperature 6 Quality
+#define HR_TI_007_QS 76  // 1-Wire Temperature 7 Quality
+#define HR_TI_CC 77      // 1-Wire devices added + removed (wraps)
 
 #define HR_CI_006_CV 82    // Current IP Address (decimal format)
 #define HR_CI_007_CV 84    // Current IP Gateway (decimal format)
@@ -204,6 +350,24 @@
 #define HW_AY_000 130     // Analog Output 0 Value (0-10V)
 #define HW_AY_001 131     // Analog Output 1 Value (0-10V)
 #define HW_ZIC_015_SP 132 // LIGHT HEIGHT DESIRED POSITION
+#define HW_AI_000_CF 133  // Analog Input 0 Filter Config (see DA_AnalogFilter)
+#define HW_AI_001_CF 134  // Analog Input 1 Filter Config
+#define HW_AI_002_CF 135  // Analog Input 2 Filter Config
+#define HW_AI_003_CF 136  // Analog Input 3 Filter Config
+#define HW_AI_004_CF 137  // Analog Input 4 Filter Config
+#define HW_AI_005_CF 138  // Analog Input 5 Filter Config
+#define HW_AI_006_CF 139  // Analog Input 6 Filter Config
+#define HW_ZIC_015_SZ 140 // LIGHT SLOWDOWN ZONE 0.1 % of travel, 0 = default
+
+// every 1-Wire slot, N = DA_MAX_ONE_WIRE_SENSORS. Slots 0..6 are also
+// HR_TI_001..007, HR_TI_00x_QS and HR_TI_00x_ID_H/L
+#define HR_TI_BLOCK 240 // slot count N
+                        // +1 bus count
+                        // +2 N temperatures * 10, -1270 empty slot
+                        // +2+N N qualities, as HR_TI_00x_QS
+                        // +2+2N N ROM codes, 4 words each, family code
+                        //   first, word k = rom[2k] << 8 | rom[2k+1]
+#define HR_TI_BLOCK_SIZE (2 + 6 * DA_MAX_ONE_WIRE_SENSORS)
 
 // TODO change address
 #define HW_CI_006_PV 50   // Change  IP Address (decimal format)
@@ -232,13 +396,28 @@ union {
   uint32_t val32[2];
 } bmacconvert;
 
+// host written state persisted for fast boot, 1 + 2 * (3 + 11) = 29 bytes.
+// Growing it moves everything from EEPROM_TOTALIZER_ADDR on
+struct _hostWritesImage {
+  uint8_t flag; // EEPROM_HOST_WRITES_SAVED when valid
+  uint16_t coils[HOST_WRITES_COIL_WORDS];
+  uint16_t registers[HOST_WRITES_REGISTER_COUNT];
+};
+
+typedef _hostWritesImage HostWritesImage;
+
 struct _lightPostionControlData {
 
   long currentPositionCount;            // encoder PV in pulses
   long previousPositionCount = -999999; // some imposible number
   bool previousZIC_015_SV = false;      // used for doing oneshot save to EEPROM
-  bool isControlling = false ; // == true when controller is moving to a new SP
+  bool previousZIC_015_FR = false;      // oneshot encoder fault reset
+  bool previousZIC_015_HM = false;      // oneshot homing start
   uint16_t setpoint;    // from HMI
+  uint16_t slowdownZone = 0xFFFF; // HW_ZIC_015_SZ last applied to lightMotion
+  uint8_t tracedState = 0;        // last traced lightMotion state
+  uint16_t tracedStatus = 0;      // last traced lightEncoder status
+  uint16_t tracedHoming = 0;      // last traced lightHoming status
   float pv;             // 0-100 to HMI
   uint32_t maxPulses =
       DEFAULT_MAX_PULSE_COUNT_LIGHT_POSITION; // determined emperically - the
@@ -0,0 +1,331 @@
+#!/usr/bin/env python3
+"""
+ @file    mbbench.py
+ @author  peter c
+ @date    2026Oct19
+ @version 0.1
+
+ @section DESCRIPTION
+ Modbus/TCP slave throughput and latency benchmark for the remote I/O
+ (host build or a panel on the bench).
+
+ Drives the slave with a weighted mix of function codes from several
+ concurrent clients, optionally pipelining requests, and reports
+ requests/s, p50/p99/p999 latency and - through the "remote t" command on
+ the command port (firmware built with MGS_MODBUS_STATS) - bytes copied and
+ time spent in MbsRun per request.
+
+ Only the scratch area from --base (200..239 by default, blocks may not run
+ into HR_TI_BLOCK at 240) is read/written. Do not point write mixes
+ at a panel that is controlling anything.
+
+ examples:
+   mbbench.py --port 10502 --cmd-port 11867 --mix 3:70,16:20,5:10
+   mbbench.py --host 192.168.0.253 --clients 4 --depth 2 --duration 30
+"""
+
+import argparse
+import random
+import re
+import socket
+import struct
+import sys
+import threading
+import time
+
+FC_READ_COILS = 1
+FC_READ_DISCRETE_INPUT = 2
+FC_READ_REGISTERS = 3
+FC_READ_INPUT_REGISTER = 4
+FC_WRITE_COIL = 5
+FC_WRITE_REGISTER = 6
+FC_WRITE_MULTIPLE_COILS = 15
+FC_WRITE_MULTIPLE_REGISTERS = 16
+
+SUPPORTED_FC = (1, 2, 3, 4, 5, 6, 15, 16)
+BIT_FC = (1, 2, 5, 15)
+
+# MbDataLen words in MgsModbus.h
+MB_DATA_LEN = 434
+DEFAULT_BASE = 200  # first word of the scratch area, 200..239 is unmapped
+SCRATCH_END = 240   # HR_TI_BLOCK, refreshed by the firmware
+
+
+def parse_pairs(text, value_type):
+    """ "3:70,16:20" -> {3: 70, 16: 20} """
+    result = {}
+    for item in text.split(','):
+        fc, value = item.split(':')
+        fc = int(fc)
+        if fc not in SUPPORTED_FC:
+            raise argparse.ArgumentTypeError('unsupported function code %d' % fc)
+        result[fc] = value_type(value)
+    return result
+
+
+class Request(object):
+    def __init__(self, fc, start, count):
+        self.fc = fc
+        self.start = start
+        self.count = count
+
+    def frame(self, tid, unit):
+        fc, start, count = self.fc, self.start, self.count
+
+        if fc in (1, 2, 3, 4):
+            pdu = struct.pack('>BHH', fc, start, count)
+        elif fc == FC_WRITE_COIL:
+            pdu = struct.pack('>BHH', fc, start, 0xFF00 if tid & 1 else 0)
+        elif fc == FC_WRITE_REGISTER:
+            pdu = struct.pack('>BHH', fc, start, tid & 0xFFFF)
+        elif fc == FC_WRITE_MULTIPLE_COILS:
+            nbytes = (count + 7) // 8
+            data = bytes((tid + i) & 0xFF for i in range(nbytes))
+            pdu = struct.pack('>BHHB', fc, start, count, nbytes) + data
+        else:
+            data = b''.join(struct.pack('>H', (tid + i) & 0xFFFF)
+                            for i in range(count))
+            pdu = struct.pack('>BHHB', fc, start, count, count * 2) + data
+
+        return struct.pack('>HHHB', tid, 0, len(pdu) + 1, unit) + pdu
+
+
+class Results(object):
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.latencies = []
+        self.errors = 0
+        self.timeouts = 0
+        self.bytes_out = 0
+        self.bytes_in = 0
+
+    def merge(self, other):
+        with self.lock:
+            self.latencies.extend(other.latencies)
+            self.errors += other.errors
+            self.timeouts += other.timeouts
+            self.bytes_out += other.bytes_out
+            self.bytes_in += other.bytes_in
+
+
+def recv_exact(sock, size):
+    data = b''
+    while len(data) < size:
+        chunk = sock.recv(size - len(data))
+        if not chunk:
+            raise ConnectionError('connection closed by slave')
+        data += chunk
+    return data
+
+
+def recv_response(sock):
+    header = recv_exact(sock, 6)
+    tid, _, length = struct.unpack('>HHH', header)
+    body = recv_exact(sock, length)
+    return tid, body, 6 + length
+
+
+class Client(threading.Thread):
+    def __init__(self, index, args, weights, blocks, deadline, quota):
+        threading.Thread.__init__(self)
+        self.daemon = True
+        self.args = args
+        self.index = index
+        self.weights = weights
+        self.blocks = blocks
+        self.deadline = deadline
+        self.quota = quota
+        self.results = Results()
+        self.random = random.Random(args.seed + index)
+        self.tid = index << 12
+
+    def connect(self):
+        sock = socket.create_connection((self.args.host, self.args.port),
+                                        timeout=self.args.timeout)
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        return sock
+
+    def next_request(self):
+        fc = self.random.choices(list(self.weights),
+                                 list(self.weights.values()))[0]
+        count = 1 if fc in (5, 6) else self.blocks.get(fc, self.args.block)
+        start = self.args.base * 16 if fc in BIT_FC else self.args.base
+        return Request(fc, start, count)
+
+    def run(self):
+        sock = None
+        done = 0
+
+        while time.monotonic() < self.deadline and (
+                self.quota is None or done < self.quota):
+            if sock is None:
+                try:
+                    sock = self.connect()
+                except OSError:
+                    self.results.errors += 1
+                    time.sleep(0.1)
+                    continue
+
+            # send the whole pipeline, then collect the answers
+            pending = {}
+            for _ in range(self.args.depth):
+                self.tid = (self.tid + 1) & 0xFFFF
+                request = self.next_request()
+                frame = request.frame(self.tid, self.args.unit)
+                pending[self.tid] = (request, time.perf_counter())
+                sock.sendall(frame)
+                self.results.bytes_out += len(frame)
+
+            try:
+                while pending:
+                    tid, body, size = recv_response(sock)
+                    now = time.perf_counter()
+                    self.results.bytes_in += size
+                    if tid not in pending:
+                        self.results.errors += 1
+                        continue
+                    request, sent = pending.pop(tid)
+                    if body[1] != request.fc:  # exception or garbage
+                        self.results.errors += 1
+                        continue
+                    self.results.latencies.append(now - sent)
+                    done += 1
+            except (socket.timeout, ConnectionError, OSError):
+                # lost frames: MbsRun answers one frame per read
+                self.results.timeouts += len(pending)
+                sock.close()
+                sock = None
+
+        if sock is not None:
+            sock.close()
+
+
+def command(args, text):
+    """ run a command on the remote I/O command port, returns its reply """
+    with socket.create_connection((args.host, args.cmd_port),
+                                  timeout=2.0) as sock:
+        sock.sendall(text.encode() + b'\n')
+        reply = b''
+        try:
+            while not reply.endswith(b'\n'):
+                chunk = sock.recv(256)
+                if not chunk:
+                    break
+                reply += chunk
+        except socket.timeout:
+            pass
+    return reply.decode(errors='replace')
+
+
+def device_stats(args):
+    if args.cmd_port == 0:
+        return None
+    try:
+        reply = command(args, 'remote t')
+    except OSError:
+        return None
+    stats = dict((k, int(v)) for k, v in re.findall(r'(\w+):(\d+)', reply))
+    return stats if 'requests' in stats else None
+
+
+def percentile(sorted_values, fraction):
+    if not sorted_values:
+        return float('nan')
+    index = min(len(sorted_values) - 1, int(fraction * len(sorted_values)))
+    return sorted_values[index]
+
+
+def report(args, results, elapsed, stats):
+    latencies = sorted(results.latencies)
+    count = len(latencies)
+
+    print('clients:%d depth:%d mix:%s' % (args.clients, args.depth, args.mix))
+    print('requests:%d errors:%d timeouts:%d elapsed:%.2fs' %
+          (count, results.errors, results.timeouts, elapsed))
+    print('throughput: %.1f req/s' % (count / elapsed if elapsed else 0))
+    print('latency ms: p50:%.3f p99:%.3f p999:%.3f max:%.3f' %
+          tuple(1000.0 * v for v in (percentile(latencies, 0.50),
+                                      percentile(latencies, 0.99),
+                                      percentile(latencies, 0.999),
+                                      latencies[-1] if count else float('nan'))))
+
+    if stats and stats['requests']:
+        n = float(stats['requests'])
+        cycles = stats.get('cyclesPerMicro', 16)
+        print('slave: requests:%d bytesCopied/req:%.1f bytesIn/req:%.1f '
+              'bytesOut/req:%.1f' % (stats['requests'],
+                                     stats['bytesCopied'] / n,
+                                     stats['bytesIn'] / n,
+                                     stats['bytesOut'] / n))
+        # cycles only mean something when the slave is the real target
+        print('slave: MbsRun us/req:%.1f max:%dus cycles/req@%dMHz:%d' %
+              (stats['busyMicros'] / n, stats['maxMicros'], cycles,
+               stats['busyMicros'] * cycles / n))
+    elif args.cmd_port:
+        print('slave: no statistics (build with MGS_MODBUS_STATS)')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__.split('@section DESCRIPTION')[1],
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('--host', default='127.0.0.1')
+    parser.add_argument('--port', type=int, default=502)
+    parser.add_argument('--cmd-port', type=int, default=1867,
+                        help='command port for slave statistics, 0 = none')
+    parser.add_argument('--unit', type=int, default=1)
+    parser.add_argument('--mix', default='3:60,16:10,1:10,5:10,6:5,15:5',
+                        help='weighted function codes fc:weight,...')
+    parser.add_argument('--block', type=int, default=8,
+                        help='registers/coils per multi-item request')
+    parser.add_argument('--blocks', default='',
+                        help='per function code block size fc:n,...')
+    parser.add_argument('--base', type=int, default=DEFAULT_BASE,
+                        help='first scratch word (coils start at base*16)')
+    parser.add_argument('--clients', type=int, default=1)
+    parser.add_argument('--depth', type=int, default=1,
+                        help='requests in flight per client (pipelining)')
+    parser.add_argument('--duration', type=float, default=10.0)
+    parser.add_argument('--requests', type=int, default=None,
+                        help='stop each client after this many requests')
+    parser.add_argument('--timeout', type=float, default=1.0)
+    parser.add_argument('--seed', type=int, default=1)
+    args = parser.parse_args()
+
+    weights = parse_pairs(args.mix, float)
+    blocks = parse_pairs(args.blocks, int) if args.blocks else {}
+
+    words = max([args.block] + list(blocks.values()))
+    # blocks stay in the region they start in, a scratch block running
+    # into HR_TI_BLOCK would no longer measure the scratch area alone
+    end = SCRATCH_END if args.base < SCRATCH_END else MB_DATA_LEN
+    if args.base + words > end:
+        parser.error('block of %d at %d runs past word %d' %
+                     (words, args.base, end))
+
+    if args.cmd_port:
+        try:
+            command(args, 'remote t r')
+        except OSError:
+            args.cmd_port = 0
+
+    deadline = time.monotonic() + args.duration
+    clients = [Client(i, args, weights, blocks, deadline, args.requests)
+               for i in range(args.clients)]
+    started = time.perf_counter()
+    for client in clients:
+        client.start()
+    for client in clients:
+        client.join()
+    elapsed = time.perf_counter() - started
+
+    results = Results()
+    for client in clients:
+        results.merge(client.results)
+
+    report(args, results, elapsed, device_stats(args))
+    return 0 if results.latencies else 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,405 @@
+/**
+ *  @file    simavr_bench.c
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Cycle accurate benchmark of the remote I/O firmware under simavr.
+ *
+ *  Runs firmware.elf from the simavr_bench env (SIMAVR_BENCH) on a
+ *  simulated 16 MHz ATmega2560 and plays a stimulus file into it:
+ *  Modbus/TCP (MBAP) frames on the benchmark UART, pin changes and
+ *  serial sensor replies. The firmware marks the end of each loop() stage
+ *  on GPIOR0 (src/DA_Bench.h) and brackets each Modbus transaction on
+ *  GPIOR1 (MgsModbus); those writes are timestamped in cycles.
+ *
+ *  SRAM is painted before reset; at the end the untouched paint gives the
+ *  heap/stack high-water marks.
+ *
+ *  usage: simavr_bench [-v] [-m max_ms] firmware.elf stimulus.txt
+ *
+ *  stimulus file, one event per line, time in ms after reset:
+ *    <ms> modbus <hex>          MBAP frame to the Modbus UART (Serial1)
+ *    <ms> serial <n> <hex>      raw bytes into USARTn, e.g. SCD30 on 2
+ *    <ms> pin <port><bit> <0|1> drive an input, e.g. "pin K6 1"
+ *    <ms> end                   stop the run
+ *  '#' starts a comment, spaces inside hex are ignored
+ **/
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <simavr/avr_ioport.h>
+#include <simavr/avr_uart.h>
+#include <simavr/sim_avr.h>
+#include <simavr/sim_cycle_timers.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+
+#define MCU_NAME "atmega2560"
+#define MCU_FREQUENCY 16000000UL
+
+#define GPIOR0_ADDR 0x3E // data space addresses on the 2560
+#define GPIOR1_ADDR 0x4A
+
+#define MODBUS_UART '1' // SIMAVR_BENCH_MODBUS_PORT in remoteIO.h
+#define UART_BAUD 115200
+#define UART_BYTE_CYCLES (MCU_FREQUENCY * 10 / UART_BAUD)
+
+#define SRAM_PAINT 0xC5
+#define MAX_EVENTS 4096
+#define MAX_BYTES 300
+#define STAGE_COUNT 13
+
+// keep in sync with src/DA_Bench.h
+static const char *stageNames[STAGE_COUNT] = {
+    "loop overhead", "modbus",         "light control", "host reads",
+    "host writes",   "1-wire",         "analogs",       "discrete inputs",
+    "timers",        "scd30",          "atlas",         "commands",
+    "scheduler"};
+
+typedef enum { EV_MODBUS, EV_SERIAL, EV_PIN, EV_END } eventType;
+
+typedef struct {
+  uint64_t cycle;
+  eventType type;
+  char port; // UART '0'..'3' or I/O port 'A'..'L'
+  uint8_t bit;
+  uint8_t level;
+  uint16_t length;
+  uint8_t bytes[MAX_BYTES];
+} stimulusEvent;
+
+typedef struct {
+  uint64_t count;
+  uint64_t total;
+  uint64_t min;
+  uint64_t max;
+} cycleStats;
+
+typedef struct {
+  avr_t *avr;
+  avr_irq_t *uartIn;
+  const uint8_t *bytes;
+  uint16_t length;
+  uint16_t next;
+} uartFeed;
+
+static stimulusEvent *events;
+static int eventCount;
+static int nextEvent;
+static int done;
+static int verbose;
+
+static cycleStats stages[STAGE_COUNT];
+static cycleStats loops;
+static cycleStats transactions;
+static uint64_t lastMark;
+static uint64_t lastLoopStart;
+static uint64_t transactionStart;
+static int haveMark;
+static uint64_t modbusBytesOut;
+
+static uartFeed feeds[4];
+
+static void addSample(cycleStats *s, uint64_t cycles) {
+  if (s->count == 0 || cycles < s->min)
+    s->min = cycles;
+  if (cycles > s->max)
+    s->max = cycles;
+  s->total += cycles;
+  s->count++;
+}
+
+static int parseHex(const char *text, uint8_t *out, int max) {
+  int n = 0;
+  int nibble = -1;
+
+  for (; *text; text++) {
+    if (isspace((unsigned char)*text))
+      continue;
+    if (!isxdigit((unsigned char)*text) || n >= max)
+      return -1;
+
+    int v = isdigit((unsigned char)*text) ? *text - '0'
+                                          : (tolower(*text) - 'a' + 10);
+    if (nibble < 0)
+      nibble = v;
+    else {
+      out[n++] = (nibble << 4) | v;
+      nibble = -1;
+    }
+  }
+  return nibble < 0 ? n : -1;
+}
+
+static int loadStimulus(const char *path) {
+  FILE *f = fopen(path, "r");
+  char line[1024];
+  int lineNo = 0;
+
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+
+  events = calloc(MAX_EVENTS, sizeof(stimulusEvent));
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    char *hash = strchr(line, '#');
+    double ms;
+    char command[16];
+    int used = 0;
+
+    lineNo++;
+    if (hash)
+      *hash = 0;
+    if (sscanf(line, "%lf %15s %n", &ms, command, &used) < 2)
+      continue;
+    if (eventCount >= MAX_EVENTS) {
+      fprintf(stderr, "%s: too many events\n", path);
+      break;
+    }
+
+    stimulusEvent *e = &events[eventCount];
+    char *args = line + used;
+    int n = 0;
+
+    e->cycle = (uint64_t)(ms * (MCU_FREQUENCY / 1000));
+
+    if (!strcmp(command, "modbus")) {
+      e->type = EV_MODBUS;
+      e->port = MODBUS_UART;
+      n = parseHex(args, e->bytes, MAX_BYTES);
+    } else if (!strcmp(command, "serial")) {
+      e->type = EV_SERIAL;
+      e->port = *args;
+      n = (e->port >= '0' && e->port <= '3') ? parseHex(args + 1, e->bytes,
+                                                         MAX_BYTES)
+                                             : -1;
+    } else if (!strcmp(command, "pin")) {
+      char port;
+      int bit, level;
+
+      e->type = EV_PIN;
+      if (sscanf(args, " %c%d %d", &port, &bit, &level) != 3 || bit > 7)
+        n = -1;
+      e->port = toupper(port);
+      e->bit = bit;
+      e->level = level != 0;
+    } else if (!strcmp(command, "end"))
+      e->type = EV_END;
+    else
+      n = -1;
+
+    if (n < 0) {
+      fprintf(stderr, "%s:%d: cannot parse '%s'\n", path, lineNo, command);
+      fclose(f);
+      return -1;
+    }
+    e->length = n;
+    eventCount++;
+  }
+  fclose(f);
+  return 0;
+}
+
+static avr_cycle_count_t feedUart(avr_t *avr, avr_cycle_count_t when,
+                                  void *param) {
+  uartFeed *feed = param;
+
+  if (feed->next >= feed->length)
+    return 0;
+
+  avr_raise_irq(feed->uartIn, feed->bytes[feed->next++]);
+  return feed->next < feed->length ? when + UART_BYTE_CYCLES : 0;
+}
+
+static void startUartFeed(avr_t *avr, const stimulusEvent *e) {
+  uartFeed *feed = &feeds[e->port - '0'];
+
+  feed->avr = avr;
+  feed->uartIn =
+      avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ(e->port), UART_IRQ_INPUT);
+  feed->bytes = e->bytes;
+  feed->length = e->length;
+  feed->next = 0;
+  avr_cycle_timer_register(avr, UART_BYTE_CYCLES, feedUart, feed);
+}
+
+static void runEvents(avr_t *avr) {
+  while (nextEvent < eventCount && events[nextEvent].cycle <= avr->cycle) {
+    stimulusEvent *e = &events[nextEvent++];
+
+    switch (e->type) {
+    case EV_MODBUS:
+    case EV_SERIAL:
+      startUartFeed(avr, e);
+      break;
+    case EV_PIN:
+      avr_raise_irq(
+          avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(e->port), e->bit),
+          e->level);
+      break;
+    case EV_END:
+      done = 1;
+      break;
+    }
+  }
+}
+
+static void onStageMark(struct avr_t *avr, avr_io_addr_t addr, uint8_t v,
+                        void *param) {
+  avr->data[addr] = v;
+
+  if (haveMark && v < STAGE_COUNT)
+    addSample(&stages[v], avr->cycle - lastMark);
+
+  if (v == 0) {
+    if (haveMark)
+      addSample(&loops, avr->cycle - lastLoopStart);
+    lastLoopStart = avr->cycle;
+  }
+  lastMark = avr->cycle;
+  haveMark = 1;
+}
+
+static void onTransactionMark(struct avr_t *avr, avr_io_addr_t addr,
+                              uint8_t v, void *param) {
+  avr->data[addr] = v;
+
+  if (v)
+    transactionStart = avr->cycle;
+  else if (transactionStart)
+    addSample(&transactions, avr->cycle - transactionStart);
+}
+
+static void onModbusOut(struct avr_irq_t *irq, uint32_t value, void *param) {
+  modbusBytesOut++;
+}
+
+static void onDebugOut(struct avr_irq_t *irq, uint32_t value, void *param) {
+  if (verbose)
+    putchar(value);
+}
+
+static void printStats(const char *name, const cycleStats *s) {
+  if (s->count == 0)
+    return;
+  printf("%-16s %8llu %10.1f %8llu %8llu %9.1f\n", name,
+         (unsigned long long)s->count, (double)s->total / s->count,
+         (unsigned long long)s->min, (unsigned long long)s->max,
+         s->max * 1e6 / MCU_FREQUENCY);
+}
+
+static void printMemory(avr_t *avr) {
+  uint16_t ramStart = avr->ioend + 1;
+  uint16_t ramEnd = avr->ramend;
+  uint16_t freeStart = ramStart;
+  uint16_t stackLow;
+
+  // static data + heap end where the longest painted run begins
+  uint16_t runStart = ramStart, bestStart = ramStart, bestLength = 0;
+
+  for (uint16_t a = ramStart; a <= ramEnd; a++) {
+    if (avr->data[a] != SRAM_PAINT) {
+      runStart = a + 1;
+      continue;
+    }
+    if (a - runStart + 1 > bestLength) {
+      bestLength = a - runStart + 1;
+      bestStart = runStart;
+    }
+  }
+  freeStart = bestStart;
+  stackLow = bestStart + bestLength;
+
+  printf("\nSRAM %u bytes: static+heap %u, stack high-water %u, "
+         "never touched %u\n",
+         ramEnd - ramStart + 1, freeStart - ramStart, ramEnd - stackLow + 1,
+         bestLength);
+}
+
+int main(int argc, char *argv[]) {
+  elf_firmware_t firmware;
+  double maxMs = 60000;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "vm:")) != -1) {
+    switch (opt) {
+    case 'v':
+      verbose = 1;
+      break;
+    case 'm':
+      maxMs = atof(optarg);
+      break;
+    default:
+      fprintf(stderr, "usage: %s [-v] [-m max_ms] firmware.elf stimulus\n",
+              argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind != 2) {
+    fprintf(stderr, "usage: %s [-v] [-m max_ms] firmware.elf stimulus\n",
+            argv[0]);
+    return 2;
+  }
+
+  memset(&firmware, 0, sizeof(firmware));
+  if (elf_read_firmware(argv[optind], &firmware) != 0) {
+    fprintf(stderr, "%s: cannot load firmware\n", argv[optind]);
+    return 1;
+  }
+  if (loadStimulus(argv[optind + 1]) != 0)
+    return 1;
+
+  avr_t *avr = avr_make_mcu_by_name(MCU_NAME);
+  if (avr == NULL) {
+    fprintf(stderr, "simavr has no %s core\n", MCU_NAME);
+    return 1;
+  }
+  avr_init(avr);
+  avr->frequency = MCU_FREQUENCY;
+  avr_load_firmware(avr, &firmware);
+
+  memset(avr->data + avr->ioend + 1, SRAM_PAINT, avr->ramend - avr->ioend);
+
+  avr_register_io_write(avr, GPIOR0_ADDR, onStageMark, NULL);
+  avr_register_io_write(avr, GPIOR1_ADDR, onTransactionMark, NULL);
+  avr_irq_register_notify(
+      avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ(MODBUS_UART), UART_IRQ_OUTPUT),
+      onModbusOut, NULL);
+  avr_irq_register_notify(
+      avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), UART_IRQ_OUTPUT),
+      onDebugOut, NULL);
+
+  uint64_t maxCycle = (uint64_t)(maxMs * (MCU_FREQUENCY / 1000));
+  int state = cpu_Running;
+
+  while (!done && avr->cycle < maxCycle && state != cpu_Done &&
+         state != cpu_Crashed) {
+    runEvents(avr);
+    state = avr_run(avr);
+  }
+
+  printf("\nsimulated %.1f ms, %llu cycles%s\n",
+         avr->cycle * 1000.0 / MCU_FREQUENCY, (unsigned long long)avr->cycle,
+         state == cpu_Crashed ? " (CRASHED)" : "");
+  printf("%-16s %8s %10s %8s %8s %9s\n", "stage", "count", "mean cyc",
+         "min", "max", "max us");
+  for (int i = 1; i < STAGE_COUNT; i++)
+    printStats(stageNames[i], &stages[i]);
+  printStats(stageNames[0], &stages[0]);
+  printStats("loop()", &loops);
+  printStats("modbus txn", &transactions);
+  printf("modbus response bytes: %llu\n", (unsigned long long)modbusBytesOut);
+  printMemory(avr);
+
+  return state == cpu_Crashed ? 1 : 0;
+}
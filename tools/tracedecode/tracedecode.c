@@ -0,0 +1,185 @@
+/**
+ *  @file    tracedecode.c
+ *  @author  peter c
+ *  @date    2026Oct19
+ *  @version 0.1
+ *
+ *
+ *  @section DESCRIPTION
+ *  Decoder for the binary event trace of the remote I/O firmware
+ *  (src/DA_Trace.h).
+ *
+ *  Reads the debug serial port capture, or the output of 'remote x' from
+ *  the command port, from a file or stdin. Trace frames
+ *    0xA5 0x5A id seq arg0(LE) arg1(LE) micros(LE, 4) crc8
+ *  are printed as text from the event table in src/DA_TraceEvents.h,
+ *  compiled in here. Anything else (log lines) is passed through, so a
+ *  mixed serial capture reads in order. Gaps in the sequence numbers are
+ *  reported as lost records. micros() wraps after ~71 min, times are
+ *  unwrapped to seconds since the first frame.
+ *
+ *  usage: tracedecode [-r] [file]
+ *    -r   raw micros() instead of seconds since the first frame
+ *  e.g. stty -F /dev/ttyACM0 19200 raw && tracedecode < /dev/ttyACM0
+ **/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define FRAME_SIZE 13 // DA_TRACE_FRAME_SIZE
+#define SYNC_0 0xA5
+#define SYNC_1 0x5A
+
+struct event {
+  const char *name;
+  const char *format;
+};
+
+static const struct event events[] = {
+#define DA_TRACE_EVENT(aId, aFormat) {#aId, aFormat},
+#include "../../src/DA_TraceEvents.h"
+#undef DA_TRACE_EVENT
+};
+
+#define EVENT_COUNT (sizeof(events) / sizeof(events[0]))
+
+// src/DA_CRC8.h
+static uint8_t crc8(const uint8_t *data, uint8_t length) {
+  uint8_t crc = 0;
+
+  while (length--) {
+    uint8_t inByte = *data++;
+
+    for (uint8_t i = 8; i; i--) {
+      uint8_t mix = (crc ^ inByte) & 0x01;
+
+      crc >>= 1;
+      if (mix)
+        crc ^= 0x8C;
+      inByte >>= 1;
+    }
+  }
+  return crc;
+}
+
+// the format with each conversion fed arg0 then arg1, %d signed
+static void print_args(const char *format, uint16_t arg0, uint16_t arg1) {
+  uint16_t args[2] = {arg0, arg1};
+  int next = 0;
+  char spec[16];
+
+  while (*format) {
+    if (*format != '%' || format[1] == '%') {
+      putchar(*format);
+      format += *format == '%' ? 2 : 1;
+      continue;
+    }
+
+    size_t length = strcspn(format + 1, "diuxXc") + 2;
+    uint16_t value = next < 2 ? args[next++] : 0;
+
+    if (length >= sizeof(spec) || length > strlen(format)) {
+      fputs(format, stdout);
+      break;
+    }
+    memcpy(spec, format, length);
+    spec[length] = '\0';
+    if (spec[length - 1] == 'd' || spec[length - 1] == 'i')
+      printf(spec, (int)(int16_t)value);
+    else
+      printf(spec, (unsigned)value);
+    format += length;
+  }
+}
+
+static int raw_times = 0;
+static int have_first = 0;
+static uint32_t last_micros;
+static uint64_t elapsed; // us since the first frame
+static uint8_t next_sequence;
+
+static void print_frame(const uint8_t *frame) {
+  uint8_t id = frame[2];
+  uint8_t sequence = frame[3];
+  uint16_t arg0 = frame[4] | frame[5] << 8;
+  uint16_t arg1 = frame[6] | frame[7] << 8;
+  uint32_t micros = (uint32_t)frame[8] | (uint32_t)frame[9] << 8 |
+                    (uint32_t)frame[10] << 16 | (uint32_t)frame[11] << 24;
+
+  if (!have_first) {
+    have_first = 1;
+    last_micros = micros;
+  } else if (sequence != next_sequence)
+    printf("... %u trace records lost\n",
+           (unsigned)(uint8_t)(sequence - next_sequence));
+  next_sequence = sequence + 1;
+  elapsed += (uint32_t)(micros - last_micros);
+  last_micros = micros;
+
+  if (raw_times)
+    printf("%10lu ", (unsigned long)micros);
+  else
+    printf("%12.6f ", elapsed / 1e6);
+
+  if (id < EVENT_COUNT) {
+    printf("%s ", events[id].name);
+    print_args(events[id].format, arg0, arg1);
+  } else
+    printf("TR_%u ? %u %u", id, arg0, arg1);
+  putchar('\n');
+  fflush(stdout);
+}
+
+static void pass_through(uint8_t *window, size_t *count) {
+  if (window[0] == '\n')
+    fflush(stdout);
+  if (window[0] != '\r')
+    putchar(window[0]);
+  memmove(window, window + 1, --*count);
+}
+
+// text until something that can start a frame
+static void realign(uint8_t *window, size_t *count) {
+  while (*count && (window[0] != SYNC_0 || (*count > 1 && window[1] != SYNC_1)))
+    pass_through(window, count);
+}
+
+int main(int argc, char **argv) {
+  FILE *in = stdin;
+  uint8_t window[FRAME_SIZE];
+  size_t count = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "r")) != -1) {
+    if (opt == 'r')
+      raw_times = 1;
+    else {
+      fprintf(stderr, "usage: %s [-r] [file]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (optind < argc && !(in = fopen(argv[optind], "rb"))) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  // slide over the input, a frame needs its sync bytes and a good CRC
+  for (int c; (c = fgetc(in)) != EOF;) {
+    window[count++] = c;
+    if (count == FRAME_SIZE) {
+      if (crc8(window + 2, FRAME_SIZE - 3) == window[FRAME_SIZE - 1]) {
+        print_frame(window);
+        count = 0;
+        continue;
+      }
+      pass_through(window, &count);
+    }
+    realign(window, &count);
+  }
+  fwrite(window, 1, count, stdout);
+  fflush(stdout);
+  return 0;
+}